@@ -16,6 +16,9 @@ pub struct ChatEvent {
 pub struct ChatState {
     messages: VecDeque<ChatMessage>,
     max_messages: usize,
+    // Total number of messages ever added; never decreases, even when old
+    // messages are trimmed, so consumers can ask for "everything after N".
+    sequence: u64,
 }
 
 impl ChatState {
@@ -23,6 +26,7 @@ impl ChatState {
         Self {
             messages: VecDeque::new(),
             max_messages: 200,
+            sequence: 0,
         }
     }
 
@@ -33,6 +37,7 @@ impl ChatState {
         };
 
         self.messages.push_back(msg);
+        self.sequence += 1;
 
         // Trim old messages
         while self.messages.len() > self.max_messages {
@@ -44,38 +49,20 @@ impl ChatState {
         &self.messages
     }
 
-    pub fn clear(&mut self) {
-        self.messages.clear();
+    /// Sequence number of the newest message (0 when nothing was ever added).
+    pub fn sequence(&self) -> u64 {
+        self.sequence
     }
-}
-
-// For C FFI (used by overlay)
-#[repr(C)]
-pub struct ChatMessageFFI {
-    pub author: [u8; 64],
-    pub text: [u8; 256],
-}
-
-impl ChatState {
-    pub fn to_ffi_messages(&self) -> Vec<ChatMessageFFI> {
-        self.messages
-            .iter()
-            .map(|msg| {
-                let mut ffi_msg = ChatMessageFFI {
-                    author: [0; 64],
-                    text: [0; 256],
-                };
-
-                let author_bytes = msg.author.as_bytes();
-                let len = author_bytes.len().min(63);
-                ffi_msg.author[..len].copy_from_slice(&author_bytes[..len]);
 
-                let text_bytes = msg.text.as_bytes();
-                let len = text_bytes.len().min(255);
-                ffi_msg.text[..len].copy_from_slice(&text_bytes[..len]);
+    /// Messages added after sequence number `since`, oldest first. Messages
+    /// that were already trimmed from the history are skipped.
+    pub fn messages_since(&self, since: u64) -> impl Iterator<Item = &ChatMessage> {
+        let new_count = self.sequence.saturating_sub(since) as usize;
+        let skip = self.messages.len().saturating_sub(new_count);
+        self.messages.iter().skip(skip)
+    }
 
-                ffi_msg
-            })
-            .collect()
+    pub fn clear(&mut self) {
+        self.messages.clear();
     }
-}
\ No newline at end of file
+}
@@ -28,6 +28,24 @@ impl EmoteCompletionProvider {
         }
     }
     
+    /// All emotes usable in `channel`, fetched once and then served from the cache
+    pub async fn channel_emotes(&self, channel: &str) -> Vec<EmoteData> {
+        let cached = {
+            let cache = self.cache.read().await;
+            cache.get(channel).cloned()
+        };
+        if let Some(cached_emotes) = cached {
+            return cached_emotes;
+        }
+
+        let fetched = self.fetch_channel_emotes(channel).await;
+        {
+            let mut cache = self.cache.write().await;
+            cache.insert(channel.to_string(), fetched.clone());
+        }
+        fetched
+    }
+
     async fn fetch_channel_emotes(&self, channel: &str) -> Vec<EmoteData> {
         let mut emotes = Vec::new();
         
@@ -95,25 +113,7 @@ impl CompletionProvider for EmoteCompletionProvider {
         prefix: &str,
     ) -> Result<Vec<CompletionItem>, Box<dyn std::error::Error + Send + Sync>> {
         let channel = context.channel().unwrap_or_default();
-        
-        // Check cache first
-        let cache_key = channel.to_string();
-        let cached = {
-            let cache = self.cache.read().await;
-            cache.get(&cache_key).cloned()
-        };
-        
-        let emotes = if let Some(cached_emotes) = cached {
-            cached_emotes
-        } else {
-            // Fetch and cache
-            let fetched = self.fetch_channel_emotes(channel).await;
-            {
-                let mut cache = self.cache.write().await;
-                cache.insert(cache_key, fetched.clone());
-            }
-            fetched
-        };
+        let emotes = self.channel_emotes(channel).await;
         
         // Filter by prefix
         let search_prefix = prefix.strip_prefix(':').unwrap_or(prefix).to_lowercase();
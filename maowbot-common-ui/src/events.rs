@@ -13,8 +13,17 @@ pub enum UIEvent {
     Dock,
 }
 
+#[derive(Clone, Copy, Debug, PartialEq, Eq)]
+pub enum AlertKind {
+    Follow,
+    Sub,
+    Redeem,
+}
+
 pub enum AppEvent {
     Chat(ChatEvent),
+    // An empty title leaves the choice to the renderer
+    Alert { kind: AlertKind, title: String, body: String },
     OverlayStatusChanged(bool),
     GrpcStatusChanged(bool),
     Shutdown,
@@ -1,9 +1,9 @@
-use crate::{AppEvent, ChatEvent};
+use crate::{AlertKind, AppEvent, ChatEvent};
 use anyhow::Result;
 use crossbeam_channel::{Receiver, Sender};
 use tokio::sync::mpsc::unbounded_channel;
 use tokio_stream::wrappers::UnboundedReceiverStream;
-use tonic::transport::{Certificate, ClientTlsConfig, Endpoint};
+use tonic::transport::{Certificate, Channel, ClientTlsConfig, Endpoint};
 
 use maowbot_proto::plugs::{
     plugin_service_client::PluginServiceClient,
@@ -11,6 +11,11 @@ use maowbot_proto::plugs::{
     plugin_stream_response::Payload as RespPayload,
     Hello, PluginCapability, PluginStreamRequest, SendChat,
 };
+use maowbot_proto::maowbot::services::{
+    twitch_event::EventData,
+    twitch_service_client::TwitchServiceClient,
+    StreamTwitchEventsRequest, TwitchEventType,
+};
 use crate::events::ChatCommand;
 
 pub struct SharedGrpcClient;
@@ -72,6 +77,7 @@ impl SharedGrpcClient {
         }
 
         let channel = endpoint.connect().await?;
+        Self::spawn_alert_stream(channel.clone(), event_tx.clone());
         let mut client = PluginServiceClient::new(channel);
 
         let (tx_out, rx_out) = unbounded_channel::<PluginStreamRequest>();
@@ -131,4 +137,62 @@ impl SharedGrpcClient {
 
         Ok(())
     }
+
+    /// Forward follows, subs and channel point redemptions as `AppEvent::Alert`
+    /// over the session's channel. A server without Twitch event streaming
+    /// just leaves alerts quiet.
+    fn spawn_alert_stream(channel: Channel, event_tx: Sender<AppEvent>) {
+        tokio::spawn(async move {
+            let mut client = TwitchServiceClient::new(channel);
+            let request = StreamTwitchEventsRequest {
+                channels: Vec::new(),
+                event_types: vec![
+                    TwitchEventType::Follow as i32,
+                    TwitchEventType::Subscription as i32,
+                    TwitchEventType::GiftSub as i32,
+                    TwitchEventType::ChannelPointRedemption as i32,
+                ],
+            };
+            let mut events = match client.stream_twitch_events(request).await {
+                Ok(response) => response.into_inner(),
+                Err(e) => {
+                    tracing::info!("Twitch event stream unavailable, no alerts: {}", e.message());
+                    return;
+                }
+            };
+
+            while let Ok(Some(event)) = events.message().await {
+                if let Some(alert) = event.event_data.and_then(Self::alert_from_twitch) {
+                    let _ = event_tx.send(alert);
+                }
+            }
+        });
+    }
+
+    /// The alert for a follow, sub or redemption; None for other event types
+    pub fn alert_from_twitch(data: EventData) -> Option<AppEvent> {
+        let (kind, title, body) = match data {
+            EventData::Follow(f) => (AlertKind::Follow, String::new(), f.username),
+            EventData::Subscription(s) => {
+                let body = if s.is_gift && s.gift_count > 1 {
+                    format!("{} gifted {} subs", s.username, s.gift_count)
+                } else if s.months > 1 {
+                    format!("{} subscribed for {} months", s.username, s.months)
+                } else {
+                    s.username
+                };
+                (AlertKind::Sub, String::new(), body)
+            }
+            EventData::Redemption(r) => {
+                let body = if r.user_input.is_empty() {
+                    r.username
+                } else {
+                    format!("{}: {}", r.username, r.user_input)
+                };
+                (AlertKind::Redeem, r.reward_title, body)
+            }
+            _ => return None,
+        };
+        Some(AppEvent::Alert { kind, title, body })
+    }
 }
\ No newline at end of file
@@ -13,7 +13,7 @@ pub use grpc::SharedGrpcClient;
 pub use grpc_client::GrpcClient;
 pub use process_manager::{ProcessManager, ProcessType, ProcessStatus};
 pub use state::{AppState, LayoutSection};
-pub use events::{UIEvent, AppEvent, ChatCommand};
+pub use events::{UIEvent, AppEvent, AlertKind, ChatCommand};
 pub use settings::{
     SettingsTab, ChatSide, StreamerListEntry, 
     UISettings, AudioSettings, StreamOverlaySettings
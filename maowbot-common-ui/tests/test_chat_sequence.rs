@@ -0,0 +1,67 @@
+#[cfg(test)]
+mod tests {
+    use maowbot_common_ui::{ChatEvent, ChatState};
+
+    fn add(state: &mut ChatState, count: usize, start: usize) {
+        for i in start..start + count {
+            state.add_message(ChatEvent {
+                channel: "test".to_string(),
+                author: format!("user{}", i),
+                body: format!("message {}", i),
+            });
+        }
+    }
+
+    fn texts_since(state: &ChatState, since: u64) -> Vec<String> {
+        state.messages_since(since).map(|m| m.text.clone()).collect()
+    }
+
+    #[test]
+    fn test_messages_since_returns_new_messages() {
+        let mut state = ChatState::new();
+        add(&mut state, 5, 0);
+        let since = state.sequence();
+        assert_eq!(since, 5);
+
+        add(&mut state, 3, 5);
+        assert_eq!(state.sequence(), 8);
+        assert_eq!(
+            texts_since(&state, since),
+            vec!["message 5", "message 6", "message 7"]
+        );
+
+        // Reading from the start returns everything still held
+        assert_eq!(texts_since(&state, 0).len(), 8);
+    }
+
+    #[test]
+    fn test_messages_since_skips_trimmed_messages() {
+        let mut state = ChatState::new();
+        add(&mut state, 10, 0);
+        let since = state.sequence();
+
+        // A burst bigger than the 200 message history
+        add(&mut state, 250, 10);
+        assert_eq!(state.sequence(), 260);
+        assert_eq!(state.messages().len(), 200);
+
+        let texts = texts_since(&state, since);
+        assert_eq!(texts.len(), 200);
+        assert_eq!(texts.first().unwrap(), "message 60");
+        assert_eq!(texts.last().unwrap(), "message 259");
+    }
+
+    #[test]
+    fn test_messages_since_with_nothing_new() {
+        let mut state = ChatState::new();
+        assert_eq!(state.sequence(), 0);
+        assert_eq!(texts_since(&state, 0).len(), 0);
+
+        add(&mut state, 4, 0);
+        let since = state.sequence();
+        assert_eq!(texts_since(&state, since).len(), 0);
+
+        // A reader ahead of the state (e.g. after a restart) gets nothing
+        assert_eq!(texts_since(&state, since + 10).len(), 0);
+    }
+}
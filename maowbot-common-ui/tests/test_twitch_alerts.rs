@@ -0,0 +1,96 @@
+#[cfg(test)]
+mod tests {
+    use maowbot_common_ui::{AlertKind, AppEvent, SharedGrpcClient};
+    use maowbot_proto::maowbot::services::{
+        twitch_event::EventData, ChannelPointRedemptionEvent, FollowEvent, RaidEvent,
+        SubscriptionEvent,
+    };
+
+    fn alert(data: EventData) -> Option<(AlertKind, String, String)> {
+        match SharedGrpcClient::alert_from_twitch(data)? {
+            AppEvent::Alert { kind, title, body } => Some((kind, title, body)),
+            _ => panic!("expected an alert event"),
+        }
+    }
+
+    #[test]
+    fn test_follow_alert() {
+        let data = EventData::Follow(FollowEvent {
+            username: "maow".to_string(),
+            ..Default::default()
+        });
+        assert_eq!(alert(data), Some((AlertKind::Follow, String::new(), "maow".to_string())));
+    }
+
+    #[test]
+    fn test_sub_alerts() {
+        let gift = EventData::Subscription(SubscriptionEvent {
+            username: "maow".to_string(),
+            is_gift: true,
+            gift_count: 5,
+            ..Default::default()
+        });
+        assert_eq!(
+            alert(gift),
+            Some((AlertKind::Sub, String::new(), "maow gifted 5 subs".to_string()))
+        );
+
+        let resub = EventData::Subscription(SubscriptionEvent {
+            username: "maow".to_string(),
+            months: 12,
+            ..Default::default()
+        });
+        assert_eq!(
+            alert(resub),
+            Some((AlertKind::Sub, String::new(), "maow subscribed for 12 months".to_string()))
+        );
+
+        // A single gift or a first month is just the name
+        let single_gift = EventData::Subscription(SubscriptionEvent {
+            username: "maow".to_string(),
+            is_gift: true,
+            gift_count: 1,
+            months: 1,
+            ..Default::default()
+        });
+        assert_eq!(alert(single_gift), Some((AlertKind::Sub, String::new(), "maow".to_string())));
+    }
+
+    #[test]
+    fn test_redeem_alerts() {
+        let plain = EventData::Redemption(ChannelPointRedemptionEvent {
+            username: "maow".to_string(),
+            reward_title: "Hydrate".to_string(),
+            ..Default::default()
+        });
+        assert_eq!(
+            alert(plain),
+            Some((AlertKind::Redeem, "Hydrate".to_string(), "maow".to_string()))
+        );
+
+        let with_input = EventData::Redemption(ChannelPointRedemptionEvent {
+            username: "maow".to_string(),
+            reward_title: "Song request".to_string(),
+            user_input: "never gonna give you up".to_string(),
+            ..Default::default()
+        });
+        assert_eq!(
+            alert(with_input),
+            Some((
+                AlertKind::Redeem,
+                "Song request".to_string(),
+                "maow: never gonna give you up".to_string()
+            ))
+        );
+    }
+
+    #[test]
+    fn test_other_events_are_not_alerts() {
+        let raid = EventData::Raid(RaidEvent {
+            from_channel_name: "maow".to_string(),
+            viewer_count: 10,
+            ..Default::default()
+        });
+        assert!(SharedGrpcClient::alert_from_twitch(raid).is_none());
+    }
+}
@@ -100,6 +100,9 @@ impl DesktopApp {
                 AppEvent::GrpcStatusChanged(connected) => {
                     *self.state.grpc_connected.lock().unwrap() = connected;
                 }
+                AppEvent::Alert { .. } => {
+                    // Alerts are drawn by the VR overlay only
+                }
                 AppEvent::Shutdown => {
                     // Don't exit immediately, let the app handle it
                 }
@@ -19,13 +19,17 @@ fn build_windows(root: &PathBuf) {
 
     println!("cargo:rustc-link-search=native={}", lib_dir.display());
     println!("cargo:rerun-if-changed=src/openvr_wrapper.cpp");
+    println!("cargo:rerun-if-changed=src/openvr_backend.h");
+    println!("cargo:rerun-if-changed=src/openvr_backend_d3d11.cpp");
     println!("cargo:rustc-link-lib=dylib=openvr_api");
     println!("cargo:rustc-link-lib=dylib=d3d11");
     println!("cargo:rustc-link-lib=dylib=dxgi");
     println!("cargo:rustc-link-lib=dylib=d3dcompiler");
 
     cc::Build::new()
+        // Shared UI core plus the render backend for this platform
         .file("src/openvr_wrapper.cpp")
+        .file("src/openvr_backend_d3d11.cpp")
         .cpp(true)
         .flag_if_supported("-std=c++17")
         .include("../vendor/openvr/headers")
@@ -55,7 +59,18 @@ fn build_linux(root: &PathBuf) {
     let lib_dir = root.join("../vendor/openvr/lib/linux64");
 
     println!("cargo:rustc-link-search=native={}", lib_dir.display());
-    println!("cargo:rerun-if-changed=src/openvr_wrapper_gl.cpp");
+    println!("cargo:rerun-if-env-changed=MAOWBOT_USE_VULKAN");
+
+    // Vulkan hands the compositor its own images; GL textures go through an
+    // interop copy inside SteamVR
+    if env::var("MAOWBOT_USE_VULKAN").is_ok() {
+        build_linux_vulkan();
+        return;
+    }
+
+    println!("cargo:rerun-if-changed=src/openvr_wrapper.cpp");
+    println!("cargo:rerun-if-changed=src/openvr_backend.h");
+    println!("cargo:rerun-if-changed=src/openvr_backend_gl.cpp");
     println!("cargo:rustc-link-lib=dylib=openvr_api");
     println!("cargo:rustc-link-lib=dylib=GL");
     println!("cargo:rustc-link-lib=dylib=GLEW");
@@ -67,7 +82,9 @@ fn build_linux(root: &PathBuf) {
     pkg_config::find_library("glew").ok();
 
     cc::Build::new()
-        .file("src/openvr_wrapper_gl.cpp")
+        // Shared UI core plus the render backend for this platform
+        .file("src/openvr_wrapper.cpp")
+        .file("src/openvr_backend_gl.cpp")
         .cpp(true)
         .flag_if_supported("-std=c++17")
         .include("../vendor/openvr/headers")
@@ -78,4 +95,30 @@ fn build_linux(root: &PathBuf) {
         .file("../vendor/imgui/imgui_widgets.cpp")
         .file("../vendor/imgui/backends/imgui_impl_opengl3.cpp")
         .compile("openvr_imgui_wrapper");
-}
\ No newline at end of file
+}
+
+fn build_linux_vulkan() {
+    println!("cargo:rerun-if-changed=src/openvr_wrapper.cpp");
+    println!("cargo:rerun-if-changed=src/openvr_backend.h");
+    println!("cargo:rerun-if-changed=src/openvr_backend_vulkan.cpp");
+    println!("cargo:rustc-link-lib=dylib=openvr_api");
+    println!("cargo:rustc-link-lib=dylib=vulkan");
+
+    #[cfg(unix)]
+    pkg_config::find_library("vulkan").ok();
+
+    cc::Build::new()
+        // Shared UI core plus the render backend for this platform
+        .file("src/openvr_wrapper.cpp")
+        .file("src/openvr_backend_vulkan.cpp")
+        .cpp(true)
+        .flag_if_supported("-std=c++17")
+        .include("../vendor/openvr/headers")
+        .include("../vendor/imgui")
+        .file("../vendor/imgui/imgui.cpp")
+        .file("../vendor/imgui/imgui_draw.cpp")
+        .file("../vendor/imgui/imgui_tables.cpp")
+        .file("../vendor/imgui/imgui_widgets.cpp")
+        .file("../vendor/imgui/backends/imgui_impl_vulkan.cpp")
+        .compile("openvr_imgui_wrapper");
+}
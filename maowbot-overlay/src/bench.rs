@@ -0,0 +1,122 @@
+//! Headless benchmark of the native overlay UI.
+//!
+//! Runs the real chat, dashboard and keyboard UI build on a null backend (no
+//! headset, no GPU) under synthetic chat load and prints per-frame CPU time,
+//! ImGui allocations and geometry for each chat rate. Needs the real native
+//! wrapper; the stub build has no ImGui to measure.
+//!
+//! `MAOWBOT_OVERLAY_BENCH=10,100,1000` runs one pass per rate in messages per
+//! second; `MAOWBOT_OVERLAY_BENCH_FRAMES` sets the frames per pass.
+
+use anyhow::{bail, Result};
+
+use crate::chat::PackedChatBatch;
+use crate::ffi;
+use crate::{DASHBOARD_HEIGHT, DASHBOARD_WIDTH};
+
+// Simulated display rate; chat arrives per simulated frame, not wall time
+const BENCH_FRAME_HZ: f64 = 90.0;
+const DEFAULT_FRAMES: usize = 900;
+const BENCH_AUTHORS: u64 = 50;
+
+pub fn run(rates: &str) -> Result<()> {
+    let rates: Vec<f64> = rates
+        .split(',')
+        .filter_map(|r| r.trim().parse::<f64>().ok())
+        .filter(|r| *r >= 0.0)
+        .collect();
+    if rates.is_empty() {
+        bail!("MAOWBOT_OVERLAY_BENCH wants comma-separated message rates, e.g. 10,100,1000");
+    }
+    let frames = std::env::var("MAOWBOT_OVERLAY_BENCH_FRAMES")
+        .ok()
+        .and_then(|v| v.parse::<usize>().ok())
+        .filter(|f| *f > 0)
+        .unwrap_or(DEFAULT_FRAMES);
+
+    if !unsafe { ffi::vr_bench_init(DASHBOARD_WIDTH, DASHBOARD_HEIGHT) } {
+        bail!("native benchmark unavailable (stub build, or ImGui already initialized)");
+    }
+
+    println!(
+        "{:>8} {:>8} {:>8} {:>8} {:>10} {:>12} {:>8} {:>8}",
+        "msg/s", "p50 ms", "p99 ms", "max ms", "allocs/f", "bytes/f", "vtx", "idx"
+    );
+    for rate in rates {
+        let samples = run_pass(rate, frames);
+        print_summary(rate, samples);
+    }
+
+    unsafe { ffi::vr_bench_shutdown() };
+    Ok(())
+}
+
+fn run_pass(rate: f64, frames: usize) -> Vec<ffi::BenchFrameStats> {
+    unsafe { ffi::imgui_chat_clear() };
+
+    let keyboard_text = b"hello chat\0";
+    let mut batch = PackedChatBatch::new();
+    let mut samples = Vec::with_capacity(frames);
+    let mut due = 0.0;
+    let mut sent = 0u64;
+
+    for frame in 0..frames {
+        due += rate / BENCH_FRAME_HZ;
+        batch.clear();
+        while due >= 1.0 {
+            let author = format!("chatter{}", sent % BENCH_AUTHORS);
+            let text = format!("synthetic message {} with a few more words to wrap", sent);
+            batch.push(&author, &text);
+            sent += 1;
+            due -= 1.0;
+        }
+        if !batch.is_empty() {
+            let (bytes, records) = (batch.bytes(), batch.records());
+            unsafe {
+                ffi::imgui_chat_append_packed(bytes.as_ptr(), bytes.len(), records.as_ptr(), records.len());
+            }
+        }
+
+        // Sweep the pointer, and a keyboard selection diagonally across the key
+        // grid and special row (keyboard texture pixels), so hover paths run too
+        let t = (frame % 180) as f32 / 180.0;
+        unsafe {
+            ffi::imgui_inject_mouse_pos(100.0 + 300.0 * t, 100.0 + 400.0 * t);
+            ffi::vr_keyboard_post(1, 10.0 + 470.0 * t, 80.0 + 190.0 * t, keyboard_text.as_ptr() as *const _);
+            ffi::imgui_publish_input();
+        }
+
+        let mut stats = ffi::BenchFrameStats::default();
+        if unsafe { ffi::vr_bench_frame(&mut stats) } {
+            samples.push(stats);
+        }
+    }
+    samples
+}
+
+fn print_summary(rate: f64, mut samples: Vec<ffi::BenchFrameStats>) {
+    if samples.is_empty() {
+        println!("{:>8} no frames", rate);
+        return;
+    }
+    let count = samples.len();
+    let allocs = samples.iter().map(|s| s.allocations as f64).sum::<f64>() / count as f64;
+    let bytes = samples.iter().map(|s| s.allocated_bytes as f64).sum::<f64>() / count as f64;
+    let vertices = samples.iter().map(|s| s.vertices).max().unwrap_or(0);
+    let indices = samples.iter().map(|s| s.indices).max().unwrap_or(0);
+
+    samples.sort_by(|a, b| a.cpu_ms.total_cmp(&b.cpu_ms));
+    let percentile = |p: f64| samples[((p * count as f64).ceil() as usize).clamp(1, count) - 1].cpu_ms;
+
+    println!(
+        "{:>8} {:>8.3} {:>8.3} {:>8.3} {:>10.1} {:>12.0} {:>8} {:>8}",
+        rate,
+        percentile(0.50),
+        percentile(0.99),
+        samples[count - 1].cpu_ms,
+        allocs,
+        bytes,
+        vertices,
+        indices
+    );
+}
@@ -1,82 +1,136 @@
-use std::collections::VecDeque;
+use std::collections::HashMap;
+use crate::ffi::ChatRecordFFI;
 
-pub struct ChatState {
-    messages: VecDeque<ChatMessage>,
-    input_buffer: String,
-    max_messages: usize,
+/// A batch of chat messages in the packed FFI encoding: every string lives
+/// in one byte arena and each message is a record of offsets into it.
+/// Author names are interned per batch, so a chatter who sends several
+/// messages in a batch is only copied once. Nothing is truncated.
+pub struct PackedChatBatch {
+    bytes: Vec<u8>,
+    records: Vec<ChatRecordFFI>,
+    authors: HashMap<String, (u32, u32)>,
 }
 
-#[repr(C)]
-pub struct ChatMessage {
-    pub author: [u8; 64],
-    pub text: [u8; 256],
-}
-
-#[derive(Clone)]
-pub struct ChatEvent {
-    pub channel: String,
-    pub author: String,
-    pub body: String,
-}
-
-pub enum ChatCommand {
-    SendMessage(String),
-}
-
-impl ChatState {
+impl PackedChatBatch {
     pub fn new() -> Self {
         Self {
-            messages: VecDeque::new(),
-            input_buffer: String::with_capacity(256),
-            max_messages: 200,
+            bytes: Vec::with_capacity(4096),
+            records: Vec::new(),
+            authors: HashMap::new(),
         }
     }
 
-    pub fn add_message(&mut self, event: ChatEvent) {
-        let mut msg = ChatMessage {
-            author: [0; 64],
-            text: [0; 256],
+    /// Empties the batch but keeps its allocations for reuse.
+    pub fn clear(&mut self) {
+        self.bytes.clear();
+        self.records.clear();
+        self.authors.clear();
+    }
+
+    pub fn push(&mut self, author: &str, text: &str) {
+        let (author_offset, author_len) = match self.authors.get(author) {
+            Some(&range) => range,
+            None => {
+                let range = Self::append(&mut self.bytes, author);
+                self.authors.insert(author.to_owned(), range);
+                range
+            }
         };
+        let (text_offset, text_len) = Self::append(&mut self.bytes, text);
 
-        // Copy author
-        let author_bytes = event.author.as_bytes();
-        let len = author_bytes.len().min(63);
-        msg.author[..len].copy_from_slice(&author_bytes[..len]);
+        self.records.push(ChatRecordFFI {
+            author_offset,
+            author_len,
+            text_offset,
+            text_len,
+        });
+    }
+
+    fn append(bytes: &mut Vec<u8>, s: &str) -> (u32, u32) {
+        let offset = bytes.len() as u32;
+        bytes.extend_from_slice(s.as_bytes());
+        (offset, s.len() as u32)
+    }
 
-        // Copy text
-        let text_bytes = event.body.as_bytes();
-        let len = text_bytes.len().min(255);
-        msg.text[..len].copy_from_slice(&text_bytes[..len]);
+    pub fn is_empty(&self) -> bool {
+        self.records.is_empty()
+    }
 
-        self.messages.push_back(msg);
+    pub fn bytes(&self) -> &[u8] {
+        &self.bytes
+    }
 
-        // Trim old messages
-        while self.messages.len() > self.max_messages {
-            self.messages.pop_front();
-        }
+    pub fn records(&self) -> &[ChatRecordFFI] {
+        &self.records
     }
+}
 
-    pub fn get_messages_ptr(&self) -> *const u8 {
-        if self.messages.is_empty() {
-            std::ptr::null()
-        } else {
-            self.messages.as_slices().0.as_ptr() as *const u8
-        }
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn field<'a>(batch: &'a PackedChatBatch, offset: u32, len: u32) -> &'a str {
+        let range = offset as usize..(offset + len) as usize;
+        std::str::from_utf8(&batch.bytes()[range]).unwrap()
     }
 
-    pub fn get_messages_count(&self) -> usize {
-        self.messages.len()
+    fn decoded(batch: &PackedChatBatch) -> Vec<(&str, &str)> {
+        batch
+            .records()
+            .iter()
+            .map(|r| {
+                (
+                    field(batch, r.author_offset, r.author_len),
+                    field(batch, r.text_offset, r.text_len),
+                )
+            })
+            .collect()
     }
 
-    pub fn get_input_buffer_ptr(&self) -> *const u8 {
-        self.input_buffer.as_ptr()
+    #[test]
+    fn repeat_authors_share_one_range() {
+        let mut batch = PackedChatBatch::new();
+        batch.push("maow", "first");
+        batch.push("other", "second");
+        batch.push("maow", "third");
+
+        assert_eq!(
+            decoded(&batch),
+            vec![("maow", "first"), ("other", "second"), ("maow", "third")]
+        );
+        let records = batch.records();
+        assert_eq!(records[0].author_offset, records[2].author_offset);
+        assert_eq!(records[0].author_len, records[2].author_len);
+        // "maow" is stored once: 4 + 5 + 5 + 6 + 5 bytes
+        assert_eq!(batch.bytes().len(), 25);
     }
 
-    pub fn get_input_buffer_ptr_mut(&mut self) -> *mut u8 {
-        self.input_buffer.as_mut_ptr()
+    #[test]
+    fn offsets_restart_after_clear() {
+        let mut batch = PackedChatBatch::new();
+        batch.push("maow", "a long first message");
+        batch.clear();
+        assert!(batch.is_empty());
+        assert!(batch.bytes().is_empty());
+
+        // The author is interned again, not pointed at the old batch's bytes
+        batch.push("other", "hi");
+        batch.push("maow", "again");
+        assert_eq!(decoded(&batch), vec![("other", "hi"), ("maow", "again")]);
+        assert_eq!(batch.records()[0].author_offset, 0);
     }
 
-    pub fn get_input_buffer_capacity(&self) -> usize {
-        self.input_buffer.capacity()
+    #[test]
+    fn empty_strings() {
+        let mut batch = PackedChatBatch::new();
+        batch.push("", "");
+        batch.push("maow", "");
+        batch.push("", "text");
+
+        assert_eq!(decoded(&batch), vec![("", ""), ("maow", ""), ("", "text")]);
+        for r in batch.records() {
+            assert!((r.author_offset + r.author_len) as usize <= batch.bytes().len());
+            assert!((r.text_offset + r.text_len) as usize <= batch.bytes().len());
+        }
     }
-}
\ No newline at end of file
+}
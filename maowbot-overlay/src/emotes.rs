@@ -0,0 +1,111 @@
+//! Chat emote images for the native renderer.
+//!
+//! The first time a chat channel shows up, its emotes (7TV, BTTV, FFZ) are
+//! listed by the common UI's emote provider. Each image is downloaded on the
+//! tokio runtime and decoded to RGBA8 on its blocking pool, so neither the
+//! network nor the decoder runs on the frame thread; the native side then
+//! fits and uploads it (see `ffi::register_emote`).
+
+use std::collections::HashSet;
+use std::sync::Arc;
+
+use maowbot_common_ui::completion::providers::EmoteCompletionProvider;
+use maowbot_common_ui::GrpcClient;
+use tokio::sync::OnceCell;
+
+use crate::ffi;
+
+// Larger downloads are skipped; emote images are a few KiB
+const MAX_EMOTE_BYTES: usize = 1 << 20;
+
+pub struct EmoteLoader {
+    grpc_url: String,
+    http: reqwest::Client,
+    // Connected on the first channel; None when the connect failed
+    provider: Arc<OnceCell<Option<EmoteCompletionProvider>>>,
+    loaded_channels: HashSet<String>,
+}
+
+impl EmoteLoader {
+    pub fn new(grpc_url: String) -> Self {
+        Self {
+            grpc_url,
+            http: reqwest::Client::new(),
+            provider: Arc::new(OnceCell::new()),
+            loaded_channels: HashSet::new(),
+        }
+    }
+
+    /// Start loading `channel`'s emotes if this is the first time it's seen.
+    /// Returns at once; the work runs on the tokio runtime.
+    pub fn load_channel(&mut self, channel: &str) {
+        if channel.is_empty() || self.loaded_channels.contains(channel) {
+            return;
+        }
+        self.loaded_channels.insert(channel.to_string());
+
+        let channel = channel.to_string();
+        let grpc_url = self.grpc_url.clone();
+        let http = self.http.clone();
+        let provider = self.provider.clone();
+        tokio::spawn(async move {
+            let provider = provider
+                .get_or_init(|| async {
+                    match GrpcClient::connect(&grpc_url).await {
+                        Ok(client) => Some(EmoteCompletionProvider::new(Arc::new(client))),
+                        Err(e) => {
+                            tracing::warn!("Emote provider unavailable: {}", e);
+                            None
+                        }
+                    }
+                })
+                .await;
+            let Some(provider) = provider else { return };
+
+            let emotes = provider.channel_emotes(&channel).await;
+            let mut registered = 0;
+            for emote in &emotes {
+                let Some(url) = &emote.url else { continue };
+                // No AVIF decoder is built in (see decode_and_register)
+                if url.ends_with(".avif") {
+                    continue;
+                }
+                let bytes = match download(&http, url).await {
+                    Ok(bytes) => bytes,
+                    Err(e) => {
+                        tracing::debug!("Emote {} download failed: {}", emote.name, e);
+                        continue;
+                    }
+                };
+                let name = emote.name.clone();
+                let decoded = tokio::task::spawn_blocking(move || decode_and_register(&name, &bytes));
+                if decoded.await.unwrap_or(false) {
+                    registered += 1;
+                }
+            }
+            tracing::info!("Registered {}/{} emotes for {}", registered, emotes.len(), channel);
+        });
+    }
+}
+
+async fn download(http: &reqwest::Client, url: &str) -> anyhow::Result<Vec<u8>> {
+    let bytes = http.get(url).send().await?.error_for_status()?.bytes().await?;
+    if bytes.len() > MAX_EMOTE_BYTES {
+        return Err(anyhow::anyhow!("{} bytes is too large", bytes.len()));
+    }
+    Ok(bytes.to_vec())
+}
+
+// Runs on the blocking pool: decoding a large or animated image takes a while.
+// PNG, GIF and WebP are decoded (the formats 7TV, BTTV and FFZ serve besides
+// AVIF); animated emotes register their first frame.
+fn decode_and_register(name: &str, bytes: &[u8]) -> bool {
+    let image = match image::load_from_memory(bytes) {
+        Ok(image) => image.into_rgba8(),
+        Err(e) => {
+            tracing::debug!("Emote {} not decodable: {}", name, e);
+            return false;
+        }
+    };
+    ffi::register_emote(name, image.as_raw(), image.width(), image.height())
+}
@@ -14,6 +14,32 @@ pub struct LaserHit {
     pub distance: f32,
 }
 
+/// Nearest hit of one controller in a `vr_test_laser_batch` call.
+#[repr(C)]
+#[derive(Clone, Copy)]
+pub struct LaserBatchHit {
+    pub hit: bool,
+    pub overlay_index: u32,
+    pub u: f32,
+    pub v: f32,
+    pub distance: f32,
+}
+
+impl LaserBatchHit {
+    pub const MISS: LaserBatchHit = LaserBatchHit {
+        hit: false,
+        overlay_index: u32::MAX,
+        u: 0.0,
+        v: 0.0,
+        distance: f32::MAX,
+    };
+
+    /// True when this is a hit on the overlay at `overlay_index`.
+    pub fn hit_on(&self, overlay_index: u32) -> bool {
+        self.hit && self.overlay_index == overlay_index
+    }
+}
+
 #[repr(C)]
 pub struct HmdMatrix34 {
     pub m: [[f32; 4]; 3],
@@ -31,14 +57,78 @@ pub struct OverlaySettingsFFI {
     pub alert_duration: f32,
 }
 
+/// One message of a packed chat batch: byte ranges into the batch arena.
+#[repr(C)]
+#[derive(Clone, Copy)]
+pub struct ChatRecordFFI {
+    pub author_offset: u32,
+    pub author_len: u32,
+    pub text_offset: u32,
+    pub text_len: u32,
+}
+
 #[repr(C)]
 pub struct DashboardState {
     pub show_settings: bool,
     pub current_tab: i32,
 }
 
+/// Percentiles over the recent samples of one frame stage, in milliseconds.
+#[repr(C)]
+#[derive(Clone, Copy, Default)]
+pub struct FrameStageStats {
+    pub last_ms: f32,
+    pub p50_ms: f32,
+    pub p99_ms: f32,
+    pub max_ms: f32,
+    pub samples: u32,
+}
+
+// Frame stages reported by `vr_get_frame_stats`
+pub const STAGE_FRAME: usize = 0;
+pub const STAGE_WAIT: usize = 1;
+pub const STAGE_CONTROLLERS: usize = 2;
+pub const STAGE_UI: usize = 3;
+pub const STAGE_DRAW: usize = 4;
+pub const STAGE_SUBMIT: usize = 5;
+pub const STAGE_GPU: usize = 6;
+pub const STAGE_COUNT: usize = 7;
+
+#[repr(C)]
+#[derive(Clone, Copy, Default)]
+pub struct FrameStats {
+    pub stages: [FrameStageStats; STAGE_COUNT],
+    /// ImGui allocations made by the last overlay UI build
+    pub ui_allocations: u32,
+    /// Of those, the ones the native ImGui heap had to take from malloc;
+    /// zero once the UI has warmed up
+    pub ui_heap_allocations: u32,
+    pub heap_allocations: u64,
+}
+
+/// One frame of the headless benchmark (`vr_bench_frame`).
+#[repr(C)]
+#[derive(Clone, Copy, Default)]
+pub struct BenchFrameStats {
+    pub cpu_ms: f64,
+    pub allocations: u32,
+    pub allocated_bytes: u64,
+    pub vertices: u32,
+    pub indices: u32,
+}
+
 pub type VROverlayHandle = u64;
 
+// Overlay ids for the native render scheduler
+pub const OVERLAY_HUD: i32 = 0;
+pub const OVERLAY_DASHBOARD: i32 = 1;
+pub const OVERLAY_KEYBOARD: i32 = 2;
+
+// Alert kinds for `vr_alert_post`
+pub const ALERT_FOLLOW: i32 = 0;
+pub const ALERT_SUB: i32 = 1;
+pub const ALERT_REDEEM: i32 = 2;
+
 extern "C" {
     // OpenVR functions
     pub fn vr_init_overlay() -> bool;
@@ -78,8 +168,17 @@ extern "C" {
     pub fn vr_get_controller_trigger_released(controller_idx: i32) -> bool;
     pub fn vr_test_laser_intersection(controller_idx: i32, handle: VROverlayHandle) -> LaserHit;
     pub fn vr_test_laser_intersection_main(controller_idx: i32) -> LaserHit;
+    pub fn vr_test_laser_batch(
+        controllers: *const i32,
+        controller_count: usize,
+        overlays: *const VROverlayHandle,
+        overlay_count: usize,
+        out_hits: *mut LaserBatchHit,
+    ) -> usize;
+    pub fn vr_get_hud_overlay_handle() -> VROverlayHandle;
     pub fn vr_trigger_haptic_pulse(controller_idx: i32, duration_us: u16);
-    pub fn vr_find_hip_tracker() -> u32;
+    pub fn vr_get_hip_tracker_changed(index: *mut u32) -> bool;
+    pub fn vr_set_hip_tracker_serial(serial: *const c_char);
 
     pub fn vr_get_controller_menu_pressed(controller_idx: i32) -> bool;
     pub fn vr_keyboard_init_rendering(device: *mut c_void, context: *mut c_void) -> bool;
@@ -89,26 +188,79 @@ extern "C" {
         selected_y: f32,
         current_text: *const c_char,
     ) -> bool;
+    pub fn vr_keyboard_post(
+        handle: VROverlayHandle,
+        selected_x: f32,
+        selected_y: f32,
+        current_text: *const c_char,
+    );
+
+    // Native render thread; while it runs Rust only posts state
+    pub fn vr_render_thread_start(
+        hud_width: u32,
+        hud_height: u32,
+        dashboard_width: u32,
+        dashboard_height: u32,
+    ) -> bool;
+    pub fn vr_render_thread_stop();
+
+    // Render target pool
+    pub fn vr_set_swapchain_buffers(count: i32);
+    pub fn vr_get_hud_target_size(width: *mut u32, height: *mut u32) -> bool;
+    pub fn vr_render_thread_submit_errors() -> u64;
+
+    // Overlay registry: runtime overlays with their own targets and rates
+    pub fn vr_registry_create(
+        key: *const c_char,
+        name: *const c_char,
+        width: u32,
+        height: u32,
+        width_m: f32,
+    ) -> i32;
+    pub fn vr_registry_destroy(id: i32);
+    pub fn vr_registry_handle(id: i32) -> VROverlayHandle;
+    pub fn vr_registry_set_visible(id: i32, visible: bool);
+    pub fn vr_registry_set_rate(id: i32, hz: f32);
+    pub fn vr_registry_set_text(id: i32, title: *const c_char, body: *const c_char);
+    pub fn vr_registry_render() -> bool;
+    pub fn vr_alert_post(kind: i32, title: *const c_char, body: *const c_char);
+    pub fn vr_emote_register(name: *const c_char, rgba: *const u8, width: u32, height: u32) -> bool;
     
     // ImGui functions
-    pub fn imgui_init(device: *mut c_void, context: *mut c_void);
+    pub fn imgui_set_font_cache_dir(dir: *const c_char);
+    pub fn imgui_init(device: *mut c_void, context: *mut c_void) -> bool;
     pub fn imgui_shutdown();
     pub fn imgui_render_and_submit(width: u32, height: u32, is_dashboard: bool) -> bool;
     pub fn imgui_render_hud(width: u32, height: u32) -> bool;
     pub fn imgui_render_dashboard(width: u32, height: u32) -> bool;
-    pub fn imgui_update_chat_state(
-        messages_ptr: *const u8,
-        messages_count: usize,
-        input_buffer: *mut u8,
-        input_capacity: usize,
-    );
+    pub fn imgui_chat_append_packed(
+        bytes_ptr: *const u8,
+        bytes_len: usize,
+        records_ptr: *const ChatRecordFFI,
+        records_count: usize,
+    ) -> u64;
+    pub fn imgui_chat_clear();
+    pub fn imgui_chat_sequence() -> u64;
+    pub fn imgui_chat_set_history_budget(bytes: usize);
     pub fn imgui_get_sent_message(buffer: *mut u8, capacity: usize) -> bool;
     pub fn imgui_inject_mouse_pos(x: f32, y: f32);
     pub fn imgui_inject_mouse_button(button: i32, down: bool);
     pub fn imgui_update_laser_state(controller_idx: i32, hit: bool, x: f32, y: f32);
     pub fn imgui_get_input_focused() -> bool;
+    pub fn imgui_set_retained_mode(enabled: bool);
+    pub fn imgui_mark_dirty();
+    pub fn imgui_publish_input();
+    pub fn vr_overlay_set_target_rate(overlay_id: i32, active_hz: f32, idle_hz: f32);
+    pub fn vr_overlay_set_quality(overlay_id: i32, supersample: f32, mipmaps: bool);
+    pub fn vr_set_damage_tracking(enabled: bool);
+    pub fn vr_set_laser_cursor_overlays(enabled: bool);
+    pub fn vr_get_frame_stats(out: *mut FrameStats) -> bool;
+    pub fn vr_bench_init(dashboard_width: u32, dashboard_height: u32) -> bool;
+    pub fn vr_bench_frame(out: *mut BenchFrameStats) -> bool;
+    pub fn vr_bench_shutdown();
     pub fn vr_get_controller_trigger_value(controller_idx: i32) -> f32;
     pub fn vr_wait_get_poses();
+    pub fn vr_wait_frame();
     
     // Dashboard settings functions
     pub fn imgui_update_dashboard_state(state: *const DashboardState);
@@ -152,6 +304,27 @@ pub fn create_overlay_raw(key: &str, name: &str, width: f32, visible: bool) -> a
     }
 }
 
+/// Register the image chat words equal to `name` draw as: decoded, tightly
+/// packed RGBA8 of `width` x `height`. Fitting and upload happen natively off
+/// the calling thread. False when the image is unusable or the queue is full.
+pub fn register_emote(name: &str, rgba: &[u8], width: u32, height: u32) -> bool {
+    if rgba.len() < width as usize * height as usize * 4 {
+        return false;
+    }
+    match CString::new(name) {
+        Ok(n) => unsafe { vr_emote_register(n.as_ptr(), rgba.as_ptr(), width, height) },
+        Err(_) => false,
+    }
+}
+
+/// Queue an alert (`ALERT_*`); an empty title uses the kind's default.
+/// Dropped while alerts are turned off in the overlay settings.
+pub fn post_alert(kind: i32, title: &str, body: &str) {
+    if let (Ok(t), Ok(b)) = (CString::new(title), CString::new(body)) {
+        unsafe { vr_alert_post(kind, t.as_ptr(), b.as_ptr()) }
+    }
+}
+
 pub fn show_dashboard(key: &str) {
     let c = CString::new(key).unwrap();
     unsafe { vr_show_dashboard(c.as_ptr()) };
@@ -162,6 +335,26 @@ pub fn set_overlay_width(meters: f32) {
     unsafe { vr_set_overlay_width_meters(meters) }
 }
 
+/// Size of the HUD texture last rendered; it follows the chat window settings
+pub fn hud_target_size() -> Option<(u32, u32)> {
+    let (mut width, mut height) = (0u32, 0u32);
+    if unsafe { vr_get_hud_target_size(&mut width, &mut height) } {
+        Some((width, height))
+    } else {
+        None
+    }
+}
+
+/// Per-stage frame timing percentiles collected natively
+pub fn frame_stats() -> Option<FrameStats> {
+    let mut stats = FrameStats::default();
+    if unsafe { vr_get_frame_stats(&mut stats) } {
+        Some(stats)
+    } else {
+        None
+    }
+}
+
 #[inline(always)]
 pub fn compositor_sync() {
     unsafe { vr_compositor_sync() }
@@ -172,15 +365,46 @@ pub fn update_controllers() {
     unsafe { vr_update_controllers() }
 }
 
-#[inline(always)]
-pub fn find_hip_tracker() -> Option<u32> {
+/// Nearest hit per controller (left, right) against `overlays`, tested in a
+/// single native call.
+pub fn test_laser_batch(overlays: &[VROverlayHandle]) -> [LaserBatchHit; 2] {
+    let controllers = [0i32, 1];
+    let mut hits = [LaserBatchHit::MISS; 2];
     unsafe {
-        let idx = vr_find_hip_tracker();
-        if idx != u32::MAX {
-            Some(idx)
-        } else {
-            None
-        }
+        vr_test_laser_batch(
+            controllers.as_ptr(),
+            controllers.len(),
+            overlays.as_ptr(),
+            overlays.len(),
+            hits.as_mut_ptr(),
+        );
+    }
+    hits
+}
+
+/// The new hip tracker if it changed since the last call (`Some(None)` when
+/// it was lost). Updated by `update_controllers` on device events.
+#[inline(always)]
+pub fn take_hip_tracker_change() -> Option<Option<u32>> {
+    let mut idx = u32::MAX;
+    if unsafe { vr_get_hip_tracker_changed(&mut idx) } {
+        Some(if idx != u32::MAX { Some(idx) } else { None })
+    } else {
+        None
+    }
+}
+
+/// Directory the built font atlas is cached in; call before `imgui_init`.
+/// The directory must exist.
+pub fn set_font_cache_dir(dir: &std::path::Path) {
+    if let Some(c_dir) = dir.to_str().and_then(|d| CString::new(d).ok()) {
+        unsafe { imgui_set_font_cache_dir(c_dir.as_ptr()) }
+    }
+}
+
+pub fn set_hip_tracker_serial(serial: &str) {
+    if let Ok(c_serial) = CString::new(serial) {
+        unsafe { vr_set_hip_tracker_serial(c_serial.as_ptr()) }
     }
 }
 
@@ -1,6 +1,7 @@
 use maowbot_common_ui::{AppState, ChatState, ChatMessage};
 use maowbot_common_ui::settings::{StreamOverlaySettings, UISettings, AudioSettings};
 use std::ffi::CString;
+use crate::chat::PackedChatBatch;
 use crate::ffi::{DashboardState, OverlaySettingsFFI};
 
 pub struct ImGuiOverlayRenderer {
@@ -8,6 +9,10 @@ pub struct ImGuiOverlayRenderer {
     input_buffer: [u8; 256],
     message_sent: bool,
     dashboard_state: DashboardState,
+    // Last shared chat sequence number handed to the native side
+    chat_seq: u64,
+    // Reused packed encoding of the messages handed over this frame
+    chat_batch: PackedChatBatch,
 }
 
 impl ImGuiOverlayRenderer {
@@ -20,23 +25,46 @@ impl ImGuiOverlayRenderer {
                 show_settings: false,
                 current_tab: 0,
             },
+            chat_seq: 0,
+            chat_batch: PackedChatBatch::new(),
         }
     }
 
     pub fn update_state(&mut self, state: &AppState) {
-        let chat_state = state.chat_state.lock().unwrap();
-        let ffi_messages = chat_state.to_ffi_messages();
+        // Only messages newer than the last handoff cross the FFI boundary;
+        // the native side keeps its own scrollback of everything already sent.
+        // Never wait on the chat lock from the frame loop: if someone else
+        // holds it, the sequence-based handoff simply catches up next frame.
+        {
+            let chat_state = match state.chat_state.try_lock() {
+                Ok(chat_state) => chat_state,
+                Err(std::sync::TryLockError::WouldBlock) => return,
+                Err(std::sync::TryLockError::Poisoned(e)) => e.into_inner(),
+            };
+            let seq = chat_state.sequence();
+            if seq == self.chat_seq {
+                return;
+            }
+
+            self.chat_batch.clear();
+            for msg in chat_state.messages_since(self.chat_seq) {
+                self.chat_batch.push(&msg.author, &msg.text);
+            }
+            self.chat_seq = seq;
+        }
+
+        if self.chat_batch.is_empty() {
+            return;
+        }
 
+        let bytes = self.chat_batch.bytes();
+        let records = self.chat_batch.records();
         unsafe {
-            crate::ffi::imgui_update_chat_state(
-                if ffi_messages.is_empty() {
-                    std::ptr::null()
-                } else {
-                    ffi_messages.as_ptr() as *const u8
-                },
-                ffi_messages.len(),
-                self.input_buffer.as_mut_ptr(),
-                self.input_buffer.len(),
+            crate::ffi::imgui_chat_append_packed(
+                bytes.as_ptr(),
+                bytes.len(),
+                records.as_ptr(),
+                records.len(),
             );
         }
     }
@@ -50,7 +50,13 @@ impl VirtualKeyboard {
         })
     }
 
-    pub fn process_input(&mut self) -> Result<Option<String>> {
+    pub fn handle(&self) -> VROverlayHandle {
+        self.handle
+    }
+
+    /// `hits` are the per-controller laser hits of this frame's batch; only
+    /// those on `overlay_index` (the keyboard's slot in the batch) count.
+    pub fn process_input(&mut self, hits: &[ffi::LaserBatchHit; 2], overlay_index: u32) -> Result<Option<String>> {
         if !self.visible {
             return Ok(None);
         }
@@ -59,15 +65,10 @@ impl VirtualKeyboard {
         self.last_hit_x = -1.0;
         self.last_hit_y = -1.0;
 
-        // Test laser intersection with keyboard overlay
         for controller_idx in 0..2 {
-            if !unsafe { ffi::vr_get_controller_connected(controller_idx) } {
-                continue;
-            }
-
-            let hit = unsafe { ffi::vr_test_laser_intersection(controller_idx, self.handle) };
+            let hit = hits[controller_idx as usize];
 
-            if hit.hit {
+            if hit.hit_on(overlay_index) {
                 // Convert to pixel coordinates (keyboard is 512x384)
                 // Fix Y-axis: OpenVR has Y=0 at bottom, but we need Y=0 at top
                 let pixel_x = hit.u * 512.0;
@@ -343,22 +344,24 @@ impl VirtualKeyboard {
         }
     }
 
+    // Pointer position on the keyboard texture, or (-1, -1) when not pointed at
+    fn selection(&self) -> (f32, f32) {
+        if self.selected_key.is_some() {
+            // This is not used anymore since we're doing hit detection differently
+            (-1.0, -1.0)
+        } else {
+            // Pass the actual hit coordinates from the last process_input call
+            (self.last_hit_x, self.last_hit_y)
+        }
+    }
+
     pub fn render(&mut self) -> Result<()> {
         if !self.visible {
             return Ok(());
         }
 
         let current_text = CString::new(self.input_buffer.as_str())?;
-
-        // Get the selected pixel coordinates for rendering
-        let (selected_x, selected_y) = if let Some(idx) = self.selected_key {
-            // This is not used anymore since we're doing hit detection differently
-            (-1.0, -1.0)
-        } else {
-            // Pass the actual hit coordinates from the last process_input call
-            // We need to store these in the struct
-            (self.last_hit_x, self.last_hit_y)
-        };
+        let (selected_x, selected_y) = self.selection();
 
         unsafe {
             vr_keyboard_render(
@@ -371,6 +374,20 @@ impl VirtualKeyboard {
 
         Ok(())
     }
+
+    /// Hand the keyboard to the native render thread with the next input
+    /// snapshot instead of drawing it here
+    pub fn post(&self) -> Result<()> {
+        let handle = if self.visible { self.handle } else { 0 };
+        let current_text = CString::new(self.input_buffer.as_str())?;
+        let (selected_x, selected_y) = self.selection();
+
+        unsafe {
+            ffi::vr_keyboard_post(handle, selected_x, selected_y, current_text.as_ptr());
+        }
+
+        Ok(())
+    }
 }
 
 impl Drop for VirtualKeyboard {
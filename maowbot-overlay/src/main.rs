@@ -1,5 +1,8 @@
 #![cfg_attr(all(not(debug_assertions), windows), windows_subsystem = "windows")]
 
+mod bench;
+mod chat;
+mod emotes;
 mod ffi;
 mod keyboard;
 mod imgui_renderer;
@@ -11,12 +14,21 @@ use std::time::{Duration, Instant};
 use tracing_subscriber::EnvFilter;
 #[cfg(windows)]
 use windows::core::Interface;
+use emotes::EmoteLoader;
 use keyboard::VirtualKeyboard;
-use maowbot_common_ui::{AppEvent, AppState, ChatEvent, SharedGrpcClient};
+use maowbot_common_ui::{AlertKind, AppEvent, AppState, ChatEvent, SharedGrpcClient};
 use imgui_renderer::ImGuiOverlayRenderer;
 use maowbot_common_ui::events::ChatCommand;
 use maowbot_common_ui::settings::{StreamOverlaySettings, UISettings, AudioSettings};
 
+// Overlay order in the laser batch
+const LASER_HUD: u32 = 0;
+const LASER_KEYBOARD: u32 = 1;
+
+// Dashboard render target, larger than the HUD for the settings UI
+const DASHBOARD_WIDTH: u32 = 1280;
+const DASHBOARD_HEIGHT: u32 = 960;
+
 struct OverlayApp {
     state: AppState,
     event_rx: Receiver<AppEvent>,
@@ -26,6 +38,16 @@ struct OverlayApp {
     keyboard: Option<VirtualKeyboard>,
     show_keyboard: bool,
     hip_tracker_index: Option<u32>,
+    // Nearest laser hit per controller this frame (see LASER_* indices)
+    laser_hits: [ffi::LaserBatchHit; 2],
+    // Chat events drained this frame, reused to avoid reallocating
+    pending_chat: Vec<ChatEvent>,
+    emotes: EmoteLoader,
+    // Overlays are drawn on the native render thread; see render_frame
+    render_thread: bool,
+    render_errors: u64,
+    // Pace with WaitGetPoses like a scene app (MAOWBOT_OVERLAY_PACING=scene)
+    scene_pacing: bool,
     renderer: ImGuiOverlayRenderer,
     // Settings
     overlay_settings: StreamOverlaySettings,
@@ -66,21 +88,90 @@ impl OverlayApp {
         // Create GPU context
         let gpu_context = Self::create_gpu_context()?;
 
+        // The font atlas is built once and cached, which keeps imgui_init
+        // short on later launches
+        if let Some(dir) = Self::font_cache_dir() {
+            ffi::set_font_cache_dir(&dir);
+        }
+
         // Initialize ImGui
         #[cfg(windows)]
-        unsafe {
+        let imgui_ready = unsafe {
             ffi::imgui_init(
                 gpu_context.device.as_raw() as *mut _,
                 gpu_context.context.as_raw() as *mut _,
-            );
-        }
-        
+            )
+        };
+
         #[cfg(not(windows))]
-        unsafe {
+        let imgui_ready = unsafe {
             ffi::imgui_init(
                 std::ptr::null_mut(),
                 std::ptr::null_mut(),
-            );
+            )
+        };
+
+        if !imgui_ready {
+            tracing::error!("render backend setup failed; the overlays can't be drawn");
+            return Err(anyhow::anyhow!("Failed to initialize the render backend"));
+        }
+
+        // Retained mode skips re-rendering overlays whose content hasn't
+        // changed; MAOWBOT_OVERLAY_RETAINED=0 redraws every frame instead.
+        let retained = std::env::var("MAOWBOT_OVERLAY_RETAINED")
+            .map(|v| v != "0")
+            .unwrap_or(true);
+        unsafe { ffi::imgui_set_retained_mode(retained) };
+
+        // Text overlays don't need headset refresh rate. Poses and controller
+        // input are still sampled every frame; 0 Hz means every frame.
+        unsafe {
+            ffi::vr_overlay_set_target_rate(ffi::OVERLAY_HUD, 60.0, 30.0);
+            ffi::vr_overlay_set_target_rate(ffi::OVERLAY_DASHBOARD, 60.0, 15.0);
+            ffi::vr_overlay_set_target_rate(ffi::OVERLAY_KEYBOARD, 0.0, 15.0);
+        }
+
+        // MAOWBOT_OVERLAY_QUALITY=high renders the text overlays supersampled
+        // into mip-mapped textures, which keeps small text stable at a distance
+        if std::env::var("MAOWBOT_OVERLAY_QUALITY").map(|v| v == "high").unwrap_or(false) {
+            unsafe {
+                ffi::vr_overlay_set_quality(ffi::OVERLAY_HUD, 2.0, true);
+                ffi::vr_overlay_set_quality(ffi::OVERLAY_KEYBOARD, 2.0, true);
+            }
+        }
+
+        // The HUD redraws only the region that changed between renders;
+        // MAOWBOT_OVERLAY_DAMAGE=0 goes back to clearing and redrawing it all.
+        if !std::env::var("MAOWBOT_OVERLAY_DAMAGE").map(|v| v != "0").unwrap_or(true) {
+            unsafe { ffi::vr_set_damage_tracking(false) };
+        }
+
+        // Laser dots are small overlays of their own so pointing doesn't
+        // redraw the HUD; MAOWBOT_OVERLAY_CURSOR=hud draws them into it.
+        if std::env::var("MAOWBOT_OVERLAY_CURSOR").map(|v| v == "hud").unwrap_or(false) {
+            unsafe { ffi::vr_set_laser_cursor_overlays(false) };
+        }
+
+        // Chat scrollback is kept natively and bounded by memory, not by
+        // message count; MAOWBOT_OVERLAY_CHAT_HISTORY_MB overrides the budget.
+        let history_mb = std::env::var("MAOWBOT_OVERLAY_CHAT_HISTORY_MB")
+            .ok()
+            .and_then(|v| v.parse::<usize>().ok())
+            .unwrap_or(8);
+        unsafe { ffi::imgui_chat_set_history_budget(history_mb * 1024 * 1024) };
+
+        // Overlay targets are double-buffered by default;
+        // MAOWBOT_OVERLAY_BUFFERS picks 1-4 buffers per overlay.
+        if let Some(buffers) = std::env::var("MAOWBOT_OVERLAY_BUFFERS")
+            .ok()
+            .and_then(|v| v.parse::<i32>().ok())
+        {
+            unsafe { ffi::vr_set_swapchain_buffers(buffers) };
+        }
+
+        // MAOWBOT_HIP_TRACKER_SERIAL pins a specific tracker as the hip tracker
+        if let Ok(serial) = std::env::var("MAOWBOT_HIP_TRACKER_SERIAL") {
+            ffi::set_hip_tracker_serial(&serial);
         }
 
         // Create channels
@@ -90,6 +181,11 @@ impl OverlayApp {
         // Create shared state
         let state = AppState::new();
 
+        // Emote images are loaded per chat channel over their own connection
+        let grpc_url = std::env::var("MAOWBOT_GRPC_URL")
+            .unwrap_or_else(|_| "https://localhost:9999".into());
+        let emotes = EmoteLoader::new(grpc_url);
+
         // Start gRPC client
         SharedGrpcClient::start(
             "maowbot-overlay".to_string(),
@@ -125,6 +221,31 @@ impl OverlayApp {
             }
         };
 
+        // The native side renders on its own thread where the backend allows
+        // it, overlapping UI build and submit with the next frame's input
+        // sampling; MAOWBOT_OVERLAY_RENDER_THREAD=0 keeps rendering inline.
+        let render_thread = std::env::var("MAOWBOT_OVERLAY_RENDER_THREAD")
+            .map(|v| v != "0")
+            .unwrap_or(true)
+            && unsafe {
+                ffi::vr_render_thread_start(
+                    gpu_context.width,
+                    gpu_context.height,
+                    DASHBOARD_WIDTH,
+                    DASHBOARD_HEIGHT,
+                )
+            };
+        // Overlays pace themselves off the vsync timing by default rather than
+        // taking WaitGetPoses, which is the scene app's frame gate
+        let scene_pacing = std::env::var("MAOWBOT_OVERLAY_PACING")
+            .map(|v| v == "scene")
+            .unwrap_or(false);
+
+        tracing::info!(
+            "Rendering overlays {}",
+            if render_thread { "on the native render thread" } else { "inline" }
+        );
+
         Ok((
             Self {
                 state,
@@ -135,6 +256,12 @@ impl OverlayApp {
                 keyboard,
                 show_keyboard: false,
                 hip_tracker_index: None,
+                laser_hits: [ffi::LaserBatchHit::MISS; 2],
+                pending_chat: Vec::new(),
+                emotes,
+                render_thread,
+                render_errors: 0,
+                scene_pacing,
                 renderer: ImGuiOverlayRenderer::new(false),  // HUD renderer
                 overlay_settings: StreamOverlaySettings::default(),
                 ui_settings: UISettings::default(),
@@ -180,52 +307,100 @@ impl OverlayApp {
     
     #[cfg(not(windows))]
     fn create_gpu_context() -> Result<GpuContext> {
-        // On Linux, OpenGL context is managed by OpenVR/ImGui
+        // On Linux the GL context, or the Vulkan backend's own device, is
+        // managed natively
         Ok(GpuContext {
             width: 1024,
             height: 768,
         })
     }
 
+    /// MAOWBOT_OVERLAY_FONT_CACHE names the cache directory ("0" disables
+    /// the cache); by default it lives in the user's cache directory.
+    fn font_cache_dir() -> Option<std::path::PathBuf> {
+        let dir = match std::env::var("MAOWBOT_OVERLAY_FONT_CACHE") {
+            Ok(v) if v == "0" => return None,
+            Ok(v) => std::path::PathBuf::from(v),
+            Err(_) => {
+                let base = if cfg!(windows) {
+                    std::env::var_os("LOCALAPPDATA").map(std::path::PathBuf::from)
+                } else {
+                    std::env::var_os("XDG_CACHE_HOME")
+                        .map(std::path::PathBuf::from)
+                        .or_else(|| std::env::var_os("HOME").map(|h| std::path::PathBuf::from(h).join(".cache")))
+                };
+                base.unwrap_or_else(std::env::temp_dir).join("maowbot").join("overlay")
+            }
+        };
+        match std::fs::create_dir_all(&dir) {
+            Ok(()) => Some(dir),
+            Err(e) => {
+                tracing::warn!("font cache disabled, can't create {}: {}", dir.display(), e);
+                None
+            }
+        }
+    }
+
     fn run(&mut self) -> Result<()> {
         let mut frame_count = 0u64;
         let mut last_fps_print = Instant::now();
 
-        // Check for hip tracker periodically
-        let mut last_hip_check = Instant::now();
-
         loop {
-            // Wait for optimal VR frame timing
-            unsafe { ffi::vr_wait_get_poses() };
+            // Wake just before the next vsync
+            if self.scene_pacing {
+                unsafe { ffi::vr_wait_get_poses() };
+            } else {
+                unsafe { ffi::vr_wait_frame() };
+            }
 
             frame_count += 1;
 
-            // Print FPS every second
+            // Print FPS and where the frame time goes every second
             if last_fps_print.elapsed() > Duration::from_secs(1) {
                 tracing::trace!("FPS: {}", frame_count);
+                if let Some(stats) = ffi::frame_stats() {
+                    let st = |i: usize| (stats.stages[i].p50_ms, stats.stages[i].p99_ms);
+                    tracing::trace!(
+                        "frame p50/p99 ms: frame {:?} wait {:?} ui {:?} draw {:?} submit {:?} gpu {:?}, ui allocs {} (heap {})",
+                        st(ffi::STAGE_FRAME),
+                        st(ffi::STAGE_WAIT),
+                        st(ffi::STAGE_UI),
+                        st(ffi::STAGE_DRAW),
+                        st(ffi::STAGE_SUBMIT),
+                        st(ffi::STAGE_GPU),
+                        stats.ui_allocations,
+                        stats.ui_heap_allocations
+                    );
+                }
                 frame_count = 0;
                 last_fps_print = Instant::now();
             }
 
-            // Process events
-            while let Ok(event) = self.event_rx.try_recv() {
+            // Process events. Chat is collected first and added under a
+            // single lock, so a burst costs one lock per frame, not one per line.
+            self.pending_chat.clear();
+            for event in self.event_rx.try_iter() {
                 match event {
                     AppEvent::Chat(chat_event) => {
-                        let mut state = self.state.chat_state.lock().unwrap();
-                        state.add_message(chat_event);
+                        self.emotes.load_channel(&chat_event.channel);
+                        self.pending_chat.push(chat_event);
+                    }
+                    AppEvent::Alert { kind, title, body } => {
+                        let kind = match kind {
+                            AlertKind::Follow => ffi::ALERT_FOLLOW,
+                            AlertKind::Sub => ffi::ALERT_SUB,
+                            AlertKind::Redeem => ffi::ALERT_REDEEM,
+                        };
+                        ffi::post_alert(kind, &title, &body);
                     }
                     AppEvent::Shutdown => return Ok(()),
                     _ => {}
                 }
             }
-
-            // Check for hip tracker every 5 seconds
-            if last_hip_check.elapsed() > Duration::from_secs(5) {
-                self.hip_tracker_index = ffi::find_hip_tracker();
-                last_hip_check = Instant::now();
-
-                if let Some(idx) = self.hip_tracker_index {
-                    tracing::info!("Found hip tracker at index {}", idx);
+            if !self.pending_chat.is_empty() {
+                let mut state = self.state.chat_state.lock().unwrap();
+                for chat_event in self.pending_chat.drain(..) {
+                    state.add_message(chat_event);
                 }
             }
 
@@ -238,6 +413,15 @@ impl OverlayApp {
             // Process controller input
             self.process_controller_input()?;
 
+            // The native side re-resolves the hip tracker on device events
+            if let Some(hip) = ffi::take_hip_tracker_change() {
+                self.hip_tracker_index = hip;
+                match hip {
+                    Some(idx) => tracing::info!("Found hip tracker at index {}", idx),
+                    None => tracing::info!("Hip tracker lost"),
+                }
+            }
+
             // Check if input field was just focused
             let input_focused = unsafe { ffi::imgui_get_input_focused() };
             if input_focused && !self.show_keyboard {
@@ -251,11 +435,13 @@ impl OverlayApp {
             // Update keyboard if visible
             if self.show_keyboard {
                 if let Some(ref mut keyboard) = self.keyboard {
-                    // Position keyboard based on hip tracker availability
+                    // Position keyboard based on hip tracker availability. The
+                    // compositor tracks the device; the native side drops
+                    // repeats of the offset it already has.
                     keyboard.position_at_hip(self.hip_tracker_index);
 
                     // Process keyboard input and check if we got text
-                    if let Some(text) = keyboard.process_input()? {
+                    if let Some(text) = keyboard.process_input(&self.laser_hits, LASER_KEYBOARD)? {
                         // Send the text through chat
                         let _ = self.command_tx.send(ChatCommand::SendMessage(text));
 
@@ -266,21 +452,48 @@ impl OverlayApp {
                 }
             }
 
+            // The render thread draws the keyboard from the snapshot
+            if self.render_thread {
+                match self.keyboard {
+                    Some(ref keyboard) => keyboard.post()?,
+                    None => unsafe { ffi::vr_keyboard_post(0, -1.0, -1.0, std::ptr::null()) },
+                }
+            }
+
+            // Hand this frame's pointer, laser and settings state to the
+            // native side as one snapshot
+            unsafe { ffi::imgui_publish_input() };
+
             // Render frame
-            self.render_frame()?;
+            if self.render_thread {
+                self.check_render_thread();
+            } else {
+                self.render_frame()?;
+            }
 
             // Handle input from ImGui
             if let Some(message) = self.renderer.get_sent_message() {
                 let _ = self.command_tx.send(ChatCommand::SendMessage(message));
             }
-
-            // No manual sleep - let VR compositor handle timing
         }
     }
 
     fn process_controller_input(&mut self) -> Result<()> {
         ffi::update_controllers();
 
+        // One native call tests both controllers against every interactive
+        // overlay and keeps the nearest hit, so the keyboard occludes the HUD
+        let hud_handle = unsafe { ffi::vr_get_hud_overlay_handle() };
+        let keyboard_handle = match self.keyboard {
+            Some(ref keyboard) if self.show_keyboard => keyboard.handle(),
+            _ => 0,
+        };
+        self.laser_hits = ffi::test_laser_batch(&[hud_handle, keyboard_handle]);
+
+        // The HUD texture is sized from the chat settings natively
+        let (hud_width, hud_height) = ffi::hud_target_size()
+            .unwrap_or((self.gpu_context.width, self.gpu_context.height));
+
         let mut current_mouse_x = -100.0;
         let mut current_mouse_y = -100.0;
         let mut trigger_down = false;
@@ -292,13 +505,12 @@ impl OverlayApp {
                 continue;
             }
 
-            // Test laser intersection with main overlay
-            let hit = unsafe { ffi::vr_test_laser_intersection_main(controller_idx) };
+            let hit = self.laser_hits[controller_idx as usize];
 
-            if hit.hit {
+            if hit.hit_on(LASER_HUD) {
                 // Convert UV to pixel coordinates
-                let x = hit.u * self.gpu_context.width as f32;
-                let y = (1.0 - hit.v) * self.gpu_context.height as f32;
+                let x = hit.u * hud_width as f32;
+                let y = (1.0 - hit.v) * hud_height as f32;
 
                 // Update laser state for rendering
                 unsafe {
@@ -364,26 +576,41 @@ impl OverlayApp {
         
         // Render Dashboard overlay (settings)
         let dashboard_ok = unsafe {
-            ffi::imgui_render_dashboard(
-                1280,  // Dashboard is larger
-                960,
-            )
+            ffi::imgui_render_dashboard(DASHBOARD_WIDTH, DASHBOARD_HEIGHT)
         };
 
         if !dashboard_ok {
             tracing::error!("Failed to submit Dashboard frame to OpenVR");
         }
 
+        // Registered overlays that are visible, in view and changed
+        if !unsafe { ffi::vr_registry_render() } {
+            tracing::error!("Failed to submit a registered overlay frame to OpenVR");
+        }
+
         // Signal we're done with this frame
         ffi::compositor_sync();
 
         Ok(())
     }
+
+    // The render thread submits on its own; surface its failures here
+    fn check_render_thread(&mut self) {
+        let errors = unsafe { ffi::vr_render_thread_submit_errors() };
+        if errors != self.render_errors {
+            tracing::error!(
+                "Failed to submit {} overlay frame(s) to OpenVR on the render thread",
+                errors - self.render_errors
+            );
+            self.render_errors = errors;
+        }
+    }
 }
 
 impl Drop for OverlayApp {
     fn drop(&mut self) {
         unsafe {
+            ffi::vr_render_thread_stop();
             ffi::imgui_shutdown();
             ffi::vr_shutdown();
         }
@@ -399,6 +626,11 @@ async fn main() -> Result<()> {
         )
         .init();
 
+    // Headless UI benchmark instead of the overlay; see bench.rs
+    if let Ok(rates) = std::env::var("MAOWBOT_OVERLAY_BENCH") {
+        return bench::run(&rates);
+    }
+
     let (mut app, _event_tx) = OverlayApp::new()?;
 
     tracing::info!("✔ Overlay started with HUD and Dashboard");
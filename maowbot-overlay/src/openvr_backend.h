@@ -0,0 +1,94 @@
+// Render backend interface of the overlay wrapper.
+//
+// openvr_wrapper.cpp holds everything the overlays share: OpenVR overlay
+// management, input, chat, the ImGui UI, scheduling, damage tracking and
+// frame stats. What touches the graphics API lives behind the functions
+// below, implemented by exactly one backend that build.rs compiles next to
+// it: openvr_backend_d3d11.cpp on Windows, openvr_backend_gl.cpp on Linux, or
+// openvr_backend_vulkan.cpp on Linux with MAOWBOT_USE_VULKAN set.
+// The selection is made at compile time, so the calls resolve at link time
+// and the core never sees a graphics API type.
+//
+// Everything but backend_init is called from whichever thread renders (the
+// caller, or the native render thread where the backend supports one).
+#pragma once
+
+#include <cstdint>
+#include <openvr.h>
+
+#include "imgui.h"
+
+// GPU objects of one render target or texture; defined by the backend
+struct BackendTarget;
+struct BackendTexture;
+
+struct RenderTarget {
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t mip_levels = 1;
+    BackendTarget* native = nullptr;
+    bool in_use = false;
+    uint64_t released_at = 0;   // Release order, oldest idle targets are freed first
+};
+
+// Pixel rect of a render target, origin top-left, max exclusive
+struct TargetRect {
+    int32_t x0, y0, x1, y1;
+};
+
+// GPU timer query slots the core cycles through
+static const int GPU_TIMER_SLOTS = 8;
+
+// ─────────────────────────── Device and ImGui Renderer ─────────────────
+// Takes the device and immediate context on D3D11; GL uses the context
+// current on the calling thread and Vulkan creates its own device. Called
+// once the ImGui context exists.
+bool backend_init(void* device_ptr, void* context_ptr);
+bool backend_ready();
+void backend_imgui_shutdown();    // Before the ImGui context is destroyed
+void backend_shutdown();          // After every target and timer is gone
+void backend_new_frame();
+void backend_render_draw_data(ImDrawData* draw_data);
+
+// Whether rendering may move to the native render thread. GL can't: its
+// context is made current by the embedding process on its own thread.
+bool backend_supports_render_thread();
+
+// ─────────────────────────── Render Targets ────────────────────────────
+// Create the GPU objects for t's size and mip count; false on failure, in
+// which case backend_destroy_target still cleans up
+bool backend_create_target(RenderTarget* t);
+void backend_destroy_target(RenderTarget* t);
+void backend_bind_target(RenderTarget* t);
+// Whether backend_clear_target honours a rect; damage tracking needs it
+bool backend_can_clear_rect();
+// Clear the bound target, whole or only `rect`
+void backend_clear_target(RenderTarget* t, const float color[4], const TargetRect* rect);
+// Fill the mip chain from the freshly rendered top level
+void backend_resolve_target(RenderTarget* t);
+vr::EVROverlayError backend_submit_target(vr::VROverlayHandle_t handle, RenderTarget* t);
+// Fence t after its submit; backend_target_idle is true again once the GPU
+// has passed the fence. Neither call waits.
+void backend_fence_target(RenderTarget* t);
+bool backend_target_idle(RenderTarget* t);
+
+// ─────────────────────────── Textures ──────────────────────────────────
+// RGBA8 textures the UI samples (the emote atlas). They start transparent
+// and are updated in place by blocks staged in upload memory, so an update
+// never waits for draws still sampling the texture. Called outside a
+// render, between the last submit and the next bind.
+BackendTexture* backend_create_texture(uint32_t width, uint32_t height);   // Null on failure
+void backend_destroy_texture(BackendTexture* t);
+// Copy a tightly packed width x height block to (x, y). False when this
+// frame's staging memory is used up; try again on a later frame.
+bool backend_update_texture(BackendTexture* t, uint32_t x, uint32_t y,
+                            uint32_t width, uint32_t height, const uint8_t* rgba);
+ImTextureID backend_texture_id(BackendTexture* t);
+
+// ─────────────────────────── GPU Timers ────────────────────────────────
+// One timer per slot, created on first use. Only one is open at a time.
+bool backend_timer_begin(int slot);
+void backend_timer_end(int slot);
+// True once the slot's result is in; *ms is negative when it is unusable
+bool backend_timer_result(int slot, double* ms);
+void backend_timer_destroy_all();
@@ -0,0 +1,274 @@
+// D3D11 render backend; see openvr_backend.h
+#include <openvr.h>
+#include <d3d11.h>
+#include <d3d11_1.h>
+#include <d3dcompiler.h>
+#include <vector>
+
+#include "imgui.h"
+#include "backends/imgui_impl_dx11.h"
+#include "openvr_backend.h"
+
+#pragma comment(lib, "d3d11.lib")
+#pragma comment(lib, "d3dcompiler.lib")
+
+using namespace vr;
+
+// ─────────────────────────── D3D11 State ───────────────────────────────
+static ID3D11Device*           g_device        = nullptr;
+static ID3D11DeviceContext*    g_context       = nullptr;
+static ID3D11DeviceContext1*   g_context1      = nullptr;  // For ClearView; null without D3D 11.1
+
+static const DXGI_FORMAT OVERLAY_TARGET_FORMAT = DXGI_FORMAT_B8G8R8A8_UNORM;
+
+bool backend_init(void* device_ptr, void* context_ptr) {
+    g_device = (ID3D11Device*)device_ptr;
+    g_context = (ID3D11DeviceContext*)context_ptr;
+    if (!g_device || !g_context) return false;
+    if (FAILED(g_context->QueryInterface(__uuidof(ID3D11DeviceContext1), (void**)&g_context1))) {
+        g_context1 = nullptr;  // Damage tracking falls back to full redraws
+    }
+    return ImGui_ImplDX11_Init(g_device, g_context);
+}
+
+bool backend_ready() {
+    return g_device != nullptr;
+}
+
+void backend_imgui_shutdown() {
+    ImGui_ImplDX11_Shutdown();
+}
+
+void backend_shutdown() {
+    if (g_context1) {
+        g_context1->Release();
+        g_context1 = nullptr;
+    }
+}
+
+void backend_new_frame() {
+    ImGui_ImplDX11_NewFrame();
+}
+
+void backend_render_draw_data(ImDrawData* draw_data) {
+    ImGui_ImplDX11_RenderDrawData(draw_data);
+}
+
+bool backend_supports_render_thread() {
+    return true;
+}
+
+// ─────────────────────────── Render Targets ────────────────────────────
+struct BackendTarget {
+    ID3D11Texture2D* texture = nullptr;
+    ID3D11RenderTargetView* rtv = nullptr;
+    ID3D11ShaderResourceView* srv = nullptr;
+    ID3D11Query* fence = nullptr;   // Event query ended after the last submit
+    bool fenced = false;
+};
+
+bool backend_create_target(RenderTarget* t) {
+    if (!g_device) return false;
+
+    D3D11_TEXTURE2D_DESC desc = {};
+    desc.Width = t->width;
+    desc.Height = t->height;
+    desc.MipLevels = t->mip_levels;
+    desc.ArraySize = 1;
+    desc.Format = OVERLAY_TARGET_FORMAT;
+    desc.SampleDesc.Count = 1;
+    desc.Usage = D3D11_USAGE_DEFAULT;
+    desc.BindFlags = D3D11_BIND_RENDER_TARGET | D3D11_BIND_SHADER_RESOURCE;
+    desc.MiscFlags = D3D11_RESOURCE_MISC_SHARED;
+    if (t->mip_levels > 1) desc.MiscFlags |= D3D11_RESOURCE_MISC_GENERATE_MIPS;
+
+    BackendTarget* native = new BackendTarget();
+    t->native = native;
+    return SUCCEEDED(g_device->CreateTexture2D(&desc, nullptr, &native->texture)) &&
+           SUCCEEDED(g_device->CreateRenderTargetView(native->texture, nullptr, &native->rtv)) &&
+           SUCCEEDED(g_device->CreateShaderResourceView(native->texture, nullptr, &native->srv));
+}
+
+void backend_destroy_target(RenderTarget* t) {
+    BackendTarget* native = t->native;
+    if (!native) return;
+    if (native->rtv) native->rtv->Release();
+    if (native->srv) native->srv->Release();
+    if (native->texture) native->texture->Release();
+    if (native->fence) native->fence->Release();
+    delete native;
+    t->native = nullptr;
+}
+
+void backend_bind_target(RenderTarget* t) {
+    g_context->OMSetRenderTargets(1, &t->native->rtv, nullptr);
+
+    D3D11_VIEWPORT vp = {};
+    vp.Width = (float)t->width;
+    vp.Height = (float)t->height;
+    vp.MaxDepth = 1.0f;
+    g_context->RSSetViewports(1, &vp);
+}
+
+bool backend_can_clear_rect() {
+    return g_context1 != nullptr;
+}
+
+void backend_clear_target(RenderTarget* t, const float color[4], const TargetRect* rect) {
+    if (!rect || !g_context1) {
+        g_context->ClearRenderTargetView(t->native->rtv, color);
+        return;
+    }
+    D3D11_RECT r = { rect->x0, rect->y0, rect->x1, rect->y1 };
+    g_context1->ClearView(t->native->rtv, color, &r, 1);
+}
+
+void backend_resolve_target(RenderTarget* t) {
+    if (t->mip_levels > 1) g_context->GenerateMips(t->native->srv);
+}
+
+EVROverlayError backend_submit_target(VROverlayHandle_t handle, RenderTarget* t) {
+    Texture_t vr_tex = {};
+    vr_tex.handle = t->native->texture;
+    vr_tex.eType = TextureType_DirectX;
+    vr_tex.eColorSpace = ColorSpace_Gamma;
+    return VROverlay()->SetOverlayTexture(handle, &vr_tex);
+}
+
+void backend_fence_target(RenderTarget* t) {
+    BackendTarget* native = t->native;
+    if (!native->fence) {
+        D3D11_QUERY_DESC desc = { D3D11_QUERY_EVENT, 0 };
+        if (FAILED(g_device->CreateQuery(&desc, &native->fence))) {
+            native->fence = nullptr;
+            return;
+        }
+    }
+    g_context->End(native->fence);
+    native->fenced = true;
+    // Hand the frame to the GPU now; the idle check polls without flushing
+    g_context->Flush();
+}
+
+bool backend_target_idle(RenderTarget* t) {
+    BackendTarget* native = t->native;
+    if (!native->fenced) return true;
+    BOOL done = FALSE;
+    if (g_context->GetData(native->fence, &done, sizeof(done), D3D11_ASYNC_GETDATA_DONOTFLUSH) != S_OK) {
+        return false;
+    }
+    native->fenced = false;
+    return true;
+}
+
+// ─────────────────────────── Textures ──────────────────────────────────
+struct BackendTexture {
+    ID3D11Texture2D* texture = nullptr;
+    ID3D11ShaderResourceView* srv = nullptr;
+};
+
+BackendTexture* backend_create_texture(uint32_t width, uint32_t height) {
+    if (!g_device) return nullptr;
+
+    D3D11_TEXTURE2D_DESC desc = {};
+    desc.Width = width;
+    desc.Height = height;
+    desc.MipLevels = 1;
+    desc.ArraySize = 1;
+    desc.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+    desc.SampleDesc.Count = 1;
+    desc.Usage = D3D11_USAGE_DEFAULT;
+    desc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+
+    std::vector<uint8_t> transparent((size_t)width * height * 4, 0);
+    D3D11_SUBRESOURCE_DATA init = { transparent.data(), width * 4, 0 };
+
+    BackendTexture* t = new BackendTexture();
+    if (FAILED(g_device->CreateTexture2D(&desc, &init, &t->texture)) ||
+        FAILED(g_device->CreateShaderResourceView(t->texture, nullptr, &t->srv))) {
+        backend_destroy_texture(t);
+        return nullptr;
+    }
+    return t;
+}
+
+void backend_destroy_texture(BackendTexture* t) {
+    if (!t) return;
+    if (t->srv) t->srv->Release();
+    if (t->texture) t->texture->Release();
+    delete t;
+}
+
+// The runtime copies the block into its own upload memory and schedules
+// the copy, which is the staging path D3D11 offers for small updates
+bool backend_update_texture(BackendTexture* t, uint32_t x, uint32_t y,
+                            uint32_t width, uint32_t height, const uint8_t* rgba) {
+    D3D11_BOX box = { x, y, 0, x + width, y + height, 1 };
+    g_context->UpdateSubresource(t->texture, 0, &box, rgba, width * 4, 0);
+    return true;
+}
+
+ImTextureID backend_texture_id(BackendTexture* t) {
+    return (ImTextureID)t->srv;
+}
+
+// ─────────────────────────── GPU Timers ────────────────────────────────
+// A timestamp pair inside a disjoint query, read back without flushing
+struct GpuTimer {
+    ID3D11Query* disjoint = nullptr;
+    ID3D11Query* begin = nullptr;
+    ID3D11Query* end = nullptr;
+};
+
+static GpuTimer g_gpu_timers[GPU_TIMER_SLOTS];
+
+static void release_gpu_timer(GpuTimer& t) {
+    if (t.disjoint) t.disjoint->Release();
+    if (t.begin) t.begin->Release();
+    if (t.end) t.end->Release();
+    t = GpuTimer();
+}
+
+bool backend_timer_begin(int slot) {
+    GpuTimer& t = g_gpu_timers[slot];
+    if (!t.disjoint) {
+        D3D11_QUERY_DESC disjoint_desc = { D3D11_QUERY_TIMESTAMP_DISJOINT, 0 };
+        D3D11_QUERY_DESC timestamp_desc = { D3D11_QUERY_TIMESTAMP, 0 };
+        if (FAILED(g_device->CreateQuery(&disjoint_desc, &t.disjoint)) ||
+            FAILED(g_device->CreateQuery(&timestamp_desc, &t.begin)) ||
+            FAILED(g_device->CreateQuery(&timestamp_desc, &t.end))) {
+            release_gpu_timer(t);
+            return false;
+        }
+    }
+    g_context->Begin(t.disjoint);
+    g_context->End(t.begin);
+    return true;
+}
+
+void backend_timer_end(int slot) {
+    GpuTimer& t = g_gpu_timers[slot];
+    g_context->End(t.end);
+    g_context->End(t.disjoint);
+}
+
+bool backend_timer_result(int slot, double* ms) {
+    GpuTimer& t = g_gpu_timers[slot];
+    D3D11_QUERY_DATA_TIMESTAMP_DISJOINT disjoint;
+    UINT64 begin = 0, end = 0;
+    if (g_context->GetData(t.disjoint, &disjoint, sizeof(disjoint), D3D11_ASYNC_GETDATA_DONOTFLUSH) != S_OK ||
+        g_context->GetData(t.begin, &begin, sizeof(begin), D3D11_ASYNC_GETDATA_DONOTFLUSH) != S_OK ||
+        g_context->GetData(t.end, &end, sizeof(end), D3D11_ASYNC_GETDATA_DONOTFLUSH) != S_OK) {
+        return false;
+    }
+    if (disjoint.Disjoint || disjoint.Frequency == 0 || end < begin) {
+        *ms = -1.0;
+    } else {
+        *ms = (double)(end - begin) * 1000.0 / (double)disjoint.Frequency;
+    }
+    return true;
+}
+
+void backend_timer_destroy_all() {
+    for (GpuTimer& t : g_gpu_timers) release_gpu_timer(t);
+}
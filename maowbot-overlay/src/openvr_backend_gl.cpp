@@ -0,0 +1,232 @@
+// OpenGL render backend; see openvr_backend.h
+#include <openvr.h>
+#include <GL/glew.h>
+#include <GL/gl.h>
+#include <vector>
+
+#include "imgui.h"
+#include "backends/imgui_impl_opengl3.h"
+#include "openvr_backend.h"
+
+using namespace vr;
+
+static const GLenum OVERLAY_TARGET_FORMAT = GL_RGBA8;
+
+bool backend_init(void* device_ptr, void* context_ptr) {
+    (void)device_ptr;
+    (void)context_ptr;
+    glewInit();
+    return ImGui_ImplOpenGL3_Init("#version 130");
+}
+
+bool backend_ready() {
+    return true;
+}
+
+void backend_imgui_shutdown() {
+    ImGui_ImplOpenGL3_Shutdown();
+}
+
+void backend_shutdown() {
+}
+
+void backend_new_frame() {
+    ImGui_ImplOpenGL3_NewFrame();
+}
+
+void backend_render_draw_data(ImDrawData* draw_data) {
+    ImGui_ImplOpenGL3_RenderDrawData(draw_data);
+}
+
+bool backend_supports_render_thread() {
+    return false;
+}
+
+// ─────────────────────────── Render Targets ────────────────────────────
+struct BackendTarget {
+    GLuint framebuffer = 0;
+    GLuint texture = 0;
+    GLsync fence = nullptr;     // Set after the last submit until it signals
+};
+
+bool backend_create_target(RenderTarget* t) {
+    BackendTarget* native = new BackendTarget();
+    t->native = native;
+    int width = (int)t->width, height = (int)t->height, mip_levels = (int)t->mip_levels;
+
+    glGenFramebuffers(1, &native->framebuffer);
+    glGenTextures(1, &native->texture);
+
+    glBindTexture(GL_TEXTURE_2D, native->texture);
+    for (int level = 0; level < mip_levels; level++) {
+        int w = width >> level, h = height >> level;
+        glTexImage2D(GL_TEXTURE_2D, level, OVERLAY_TARGET_FORMAT, w > 0 ? w : 1, h > 0 ? h : 1, 0,
+                     GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    }
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, mip_levels - 1);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, mip_levels > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, native->framebuffer);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, native->texture, 0);
+
+    GLenum status = glCheckFramebufferStatus(GL_FRAMEBUFFER);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    return status == GL_FRAMEBUFFER_COMPLETE;
+}
+
+void backend_destroy_target(RenderTarget* t) {
+    BackendTarget* native = t->native;
+    if (!native) return;
+    if (native->framebuffer) glDeleteFramebuffers(1, &native->framebuffer);
+    if (native->texture) glDeleteTextures(1, &native->texture);
+    if (native->fence) glDeleteSync(native->fence);
+    delete native;
+    t->native = nullptr;
+}
+
+void backend_bind_target(RenderTarget* t) {
+    glBindFramebuffer(GL_FRAMEBUFFER, t->native->framebuffer);
+    glViewport(0, 0, (GLsizei)t->width, (GLsizei)t->height);
+}
+
+bool backend_can_clear_rect() {
+    return true;
+}
+
+void backend_clear_target(RenderTarget* t, const float color[4], const TargetRect* rect) {
+    glClearColor(color[0], color[1], color[2], color[3]);
+    if (!rect) {
+        glClear(GL_COLOR_BUFFER_BIT);
+        return;
+    }
+    // GL's window origin is bottom-left
+    glEnable(GL_SCISSOR_TEST);
+    glScissor(rect->x0, (GLint)t->height - rect->y1, rect->x1 - rect->x0, rect->y1 - rect->y0);
+    glClear(GL_COLOR_BUFFER_BIT);
+    glDisable(GL_SCISSOR_TEST);
+}
+
+void backend_resolve_target(RenderTarget* t) {
+    if (t->mip_levels <= 1) return;
+    glBindTexture(GL_TEXTURE_2D, t->native->texture);
+    glGenerateMipmap(GL_TEXTURE_2D);
+    glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+EVROverlayError backend_submit_target(VROverlayHandle_t handle, RenderTarget* t) {
+    Texture_t vr_tex = {};
+    vr_tex.handle = (void*)(uintptr_t)t->native->texture;
+    vr_tex.eType = TextureType_OpenGL;
+    vr_tex.eColorSpace = ColorSpace_Gamma;
+    return VROverlay()->SetOverlayTexture(handle, &vr_tex);
+}
+
+void backend_fence_target(RenderTarget* t) {
+    BackendTarget* native = t->native;
+    if (native->fence) glDeleteSync(native->fence);
+    native->fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    // Hand the frame to the GPU now; the idle check polls without flushing
+    glFlush();
+}
+
+bool backend_target_idle(RenderTarget* t) {
+    BackendTarget* native = t->native;
+    if (!native->fence) return true;
+    GLenum status = glClientWaitSync(native->fence, 0, 0);
+    if (status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED) return false;
+    glDeleteSync(native->fence);
+    native->fence = nullptr;
+    return true;
+}
+
+// ─────────────────────────── Textures ──────────────────────────────────
+struct BackendTexture {
+    GLuint texture = 0;
+    GLuint upload_buffer = 0;   // Pixel unpack buffer the blocks are staged in
+};
+
+BackendTexture* backend_create_texture(uint32_t width, uint32_t height) {
+    BackendTexture* t = new BackendTexture();
+    std::vector<uint8_t> transparent((size_t)width * height * 4, 0);
+
+    glGenTextures(1, &t->texture);
+    glBindTexture(GL_TEXTURE_2D, t->texture);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, (GLsizei)width, (GLsizei)height, 0,
+                 GL_RGBA, GL_UNSIGNED_BYTE, transparent.data());
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    glGenBuffers(1, &t->upload_buffer);
+    if (!t->texture || !t->upload_buffer) {
+        backend_destroy_texture(t);
+        return nullptr;
+    }
+    return t;
+}
+
+void backend_destroy_texture(BackendTexture* t) {
+    if (!t) return;
+    if (t->texture) glDeleteTextures(1, &t->texture);
+    if (t->upload_buffer) glDeleteBuffers(1, &t->upload_buffer);
+    delete t;
+}
+
+bool backend_update_texture(BackendTexture* t, uint32_t x, uint32_t y,
+                            uint32_t width, uint32_t height, const uint8_t* rgba) {
+    GLsizeiptr bytes = (GLsizeiptr)width * height * 4;
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, t->upload_buffer);
+    // Orphan the previous block, which a pending copy may still read
+    glBufferData(GL_PIXEL_UNPACK_BUFFER, bytes, nullptr, GL_STREAM_DRAW);
+    glBufferSubData(GL_PIXEL_UNPACK_BUFFER, 0, bytes, rgba);
+
+    glBindTexture(GL_TEXTURE_2D, t->texture);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, (GLint)x, (GLint)y, (GLsizei)width, (GLsizei)height,
+                    GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    return true;
+}
+
+ImTextureID backend_texture_id(BackendTexture* t) {
+    return (ImTextureID)(intptr_t)t->texture;
+}
+
+// ─────────────────────────── GPU Timers ────────────────────────────────
+// GL_TIME_ELAPSED queries can't nest, which the core already guarantees
+static GLuint g_gpu_timer_queries[GPU_TIMER_SLOTS] = {};
+
+bool backend_timer_begin(int slot) {
+    GLuint& query = g_gpu_timer_queries[slot];
+    if (!query) glGenQueries(1, &query);
+    glBeginQuery(GL_TIME_ELAPSED, query);
+    return true;
+}
+
+void backend_timer_end(int slot) {
+    (void)slot;
+    glEndQuery(GL_TIME_ELAPSED);
+}
+
+bool backend_timer_result(int slot, double* ms) {
+    GLint available = 0;
+    glGetQueryObjectiv(g_gpu_timer_queries[slot], GL_QUERY_RESULT_AVAILABLE, &available);
+    if (!available) return false;
+    GLuint64 elapsed_ns = 0;
+    glGetQueryObjectui64v(g_gpu_timer_queries[slot], GL_QUERY_RESULT, &elapsed_ns);
+    *ms = (double)elapsed_ns / 1.0e6;
+    return true;
+}
+
+void backend_timer_destroy_all() {
+    for (GLuint& query : g_gpu_timer_queries) {
+        if (query) glDeleteQueries(1, &query);
+        query = 0;
+    }
+}
@@ -0,0 +1,806 @@
+// Vulkan render backend; see openvr_backend.h
+//
+// SteamVR's compositor is Vulkan on Linux, so targets rendered here are
+// handed over as VRVulkanTextureData_t with no GL interop copy. The backend
+// owns its instance and device: both are created with the extensions the
+// compositor asks for, on the physical device it reports, so imgui_init
+// gets no device from Rust.
+//
+// Commands are recorded into a small ring of command buffers. A recording
+// opens on the first GPU call of a render and is submitted with its fence in
+// backend_submit_target; reusing a command buffer waits for that fence,
+// which in practice signalled long ago.
+#include <openvr.h>
+#include <vulkan/vulkan.h>
+#include <vector>
+#include <string>
+#include <cstring>
+
+#include "imgui.h"
+#include "backends/imgui_impl_vulkan.h"
+#include "openvr_backend.h"
+
+using namespace vr;
+
+// Overlays are submitted with ColorSpace_Gamma, so the target stays UNORM
+static const VkFormat OVERLAY_TARGET_FORMAT = VK_FORMAT_R8G8B8A8_UNORM;
+
+// Recordings in flight. ImGui_ImplVulkan cycles its vertex buffers over as
+// many frames, and each recording draws once, so a buffer is only reused
+// after the fence of the recording that last drew from it.
+static const uint32_t COMMAND_RING_SIZE = 8;
+
+// ─────────────────────────── Vulkan State ──────────────────────────────
+static VkInstance       g_instance        = VK_NULL_HANDLE;
+static VkPhysicalDevice g_physical_device = VK_NULL_HANDLE;
+static VkDevice         g_device          = VK_NULL_HANDLE;
+static VkQueue          g_queue           = VK_NULL_HANDLE;
+static uint32_t         g_queue_family    = 0;
+static VkRenderPass     g_render_pass     = VK_NULL_HANDLE;
+static VkDescriptorPool g_descriptor_pool = VK_NULL_HANDLE;
+static VkCommandPool    g_command_pool    = VK_NULL_HANDLE;
+static bool             g_imgui_ready     = false;
+
+struct Recording {
+    VkCommandBuffer commands = VK_NULL_HANDLE;
+    VkFence fence = VK_NULL_HANDLE;
+};
+
+static Recording g_recordings[COMMAND_RING_SIZE];
+static uint32_t g_recording_next = 0;
+static VkCommandBuffer g_recording = VK_NULL_HANDLE;  // Open recording, if any
+static uint32_t g_recording_slot = 0;                 // Its index in the ring
+static VkFence g_submitted_fence = VK_NULL_HANDLE;    // Of the last submitted recording
+static bool g_in_render_pass = false;
+
+// GPU timers: a begin/end timestamp pair per slot
+enum TimerSlotState { TIMER_NEEDS_RESET = 0, TIMER_READY, TIMER_WRITTEN };
+
+static VkQueryPool g_timer_pool = VK_NULL_HANDLE;
+static float g_timestamp_period_ns = 0.0f;           // 0 when the queue can't time
+static TimerSlotState g_timer_state[GPU_TIMER_SLOTS] = {};
+
+static void reset_gpu_timers(VkCommandBuffer cmd);
+
+// Texture uploads are staged in one persistently mapped buffer holding a
+// slice per recording of the ring, so a slice is only rewritten once the
+// recording that copied from it has completed
+static const VkDeviceSize STAGING_SLICE_SIZE = 256 * 1024;
+
+static VkBuffer       g_staging_buffer = VK_NULL_HANDLE;
+static VkDeviceMemory g_staging_memory = VK_NULL_HANDLE;
+static uint8_t*       g_staging_mapped = nullptr;
+static VkDeviceSize   g_staging_used   = 0;    // In the open recording's slice
+
+static void destroy_staging_buffer();
+
+// OpenVR reports required extensions as one space-separated string
+static std::vector<std::string> split_extensions(const char* list) {
+    std::vector<std::string> out;
+    std::string current;
+    for (const char* c = list; ; c++) {
+        if (*c == ' ' || *c == 0) {
+            if (!current.empty()) out.push_back(current);
+            current.clear();
+            if (*c == 0) break;
+        } else {
+            current += *c;
+        }
+    }
+    return out;
+}
+
+static std::vector<const char*> extension_pointers(const std::vector<std::string>& names) {
+    std::vector<const char*> out;
+    for (const std::string& name : names) out.push_back(name.c_str());
+    return out;
+}
+
+static bool create_instance() {
+    std::vector<std::string> extensions;
+    if (IVRCompositor* vrc = VRCompositor()) {
+        uint32_t size = vrc->GetVulkanInstanceExtensionsRequired(nullptr, 0);
+        if (size > 0) {
+            std::vector<char> list(size);
+            vrc->GetVulkanInstanceExtensionsRequired(list.data(), size);
+            extensions = split_extensions(list.data());
+        }
+    }
+    std::vector<const char*> names = extension_pointers(extensions);
+
+    VkApplicationInfo app = {};
+    app.sType = VK_STRUCTURE_TYPE_APPLICATION_INFO;
+    app.pApplicationName = "maowbot-overlay";
+    app.apiVersion = VK_API_VERSION_1_1;
+
+    VkInstanceCreateInfo info = {};
+    info.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
+    info.pApplicationInfo = &app;
+    info.enabledExtensionCount = (uint32_t)names.size();
+    info.ppEnabledExtensionNames = names.data();
+    return vkCreateInstance(&info, nullptr, &g_instance) == VK_SUCCESS;
+}
+
+// The compositor's GPU if it names one, else the first device
+static bool pick_physical_device() {
+    uint64_t output = 0;
+    if (IVRSystem* vrs = VRSystem()) {
+        vrs->GetOutputDevice(&output, TextureType_Vulkan, (VkInstance_T*)g_instance);
+    }
+    if (output) {
+        g_physical_device = (VkPhysicalDevice)output;
+    } else {
+        uint32_t count = 1;
+        VkResult res = vkEnumeratePhysicalDevices(g_instance, &count, &g_physical_device);
+        if ((res != VK_SUCCESS && res != VK_INCOMPLETE) || count == 0) return false;
+    }
+
+    uint32_t family_count = 0;
+    vkGetPhysicalDeviceQueueFamilyProperties(g_physical_device, &family_count, nullptr);
+    std::vector<VkQueueFamilyProperties> families(family_count);
+    vkGetPhysicalDeviceQueueFamilyProperties(g_physical_device, &family_count, families.data());
+    for (uint32_t i = 0; i < family_count; i++) {
+        if (families[i].queueFlags & VK_QUEUE_GRAPHICS_BIT) {
+            g_queue_family = i;
+            if (families[i].timestampValidBits > 0) {
+                VkPhysicalDeviceProperties props;
+                vkGetPhysicalDeviceProperties(g_physical_device, &props);
+                g_timestamp_period_ns = props.limits.timestampPeriod;
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool create_device() {
+    std::vector<std::string> extensions;
+    if (IVRCompositor* vrc = VRCompositor()) {
+        uint32_t size = vrc->GetVulkanDeviceExtensionsRequired(g_physical_device, nullptr, 0);
+        if (size > 0) {
+            std::vector<char> list(size);
+            vrc->GetVulkanDeviceExtensionsRequired(g_physical_device, list.data(), size);
+            extensions = split_extensions(list.data());
+        }
+    }
+    std::vector<const char*> names = extension_pointers(extensions);
+
+    float priority = 1.0f;
+    VkDeviceQueueCreateInfo queue = {};
+    queue.sType = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
+    queue.queueFamilyIndex = g_queue_family;
+    queue.queueCount = 1;
+    queue.pQueuePriorities = &priority;
+
+    VkDeviceCreateInfo info = {};
+    info.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
+    info.queueCreateInfoCount = 1;
+    info.pQueueCreateInfos = &queue;
+    info.enabledExtensionCount = (uint32_t)names.size();
+    info.ppEnabledExtensionNames = names.data();
+    if (vkCreateDevice(g_physical_device, &info, nullptr, &g_device) != VK_SUCCESS) return false;
+    vkGetDeviceQueue(g_device, g_queue_family, 0, &g_queue);
+    return true;
+}
+
+// Targets keep their content between renders (damage tracking redraws only
+// part of them), so the pass loads and the clear happens inside it
+static bool create_render_pass() {
+    VkAttachmentDescription color = {};
+    color.format = OVERLAY_TARGET_FORMAT;
+    color.samples = VK_SAMPLE_COUNT_1_BIT;
+    color.loadOp = VK_ATTACHMENT_LOAD_OP_LOAD;
+    color.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
+    color.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
+    color.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+    color.initialLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+    color.finalLayout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+
+    VkAttachmentReference ref = { 0, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL };
+    VkSubpassDescription subpass = {};
+    subpass.pipelineBindPoint = VK_PIPELINE_BIND_POINT_GRAPHICS;
+    subpass.colorAttachmentCount = 1;
+    subpass.pColorAttachments = &ref;
+
+    VkRenderPassCreateInfo info = {};
+    info.sType = VK_STRUCTURE_TYPE_RENDER_PASS_CREATE_INFO;
+    info.attachmentCount = 1;
+    info.pAttachments = &color;
+    info.subpassCount = 1;
+    info.pSubpasses = &subpass;
+    return vkCreateRenderPass(g_device, &info, nullptr, &g_render_pass) == VK_SUCCESS;
+}
+
+static bool create_pools() {
+    // Only the font and emote atlases need descriptors
+    VkDescriptorPoolSize size = { VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 4 };
+    VkDescriptorPoolCreateInfo descriptors = {};
+    descriptors.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+    descriptors.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT;
+    descriptors.maxSets = 4;
+    descriptors.poolSizeCount = 1;
+    descriptors.pPoolSizes = &size;
+    if (vkCreateDescriptorPool(g_device, &descriptors, nullptr, &g_descriptor_pool) != VK_SUCCESS) {
+        return false;
+    }
+
+    VkCommandPoolCreateInfo commands = {};
+    commands.sType = VK_STRUCTURE_TYPE_COMMAND_POOL_CREATE_INFO;
+    commands.flags = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT;
+    commands.queueFamilyIndex = g_queue_family;
+    if (vkCreateCommandPool(g_device, &commands, nullptr, &g_command_pool) != VK_SUCCESS) return false;
+
+    for (Recording& r : g_recordings) {
+        VkCommandBufferAllocateInfo alloc = {};
+        alloc.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+        alloc.commandPool = g_command_pool;
+        alloc.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+        alloc.commandBufferCount = 1;
+        VkFenceCreateInfo fence = {};
+        fence.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+        fence.flags = VK_FENCE_CREATE_SIGNALED_BIT;
+        if (vkAllocateCommandBuffers(g_device, &alloc, &r.commands) != VK_SUCCESS ||
+            vkCreateFence(g_device, &fence, nullptr, &r.fence) != VK_SUCCESS) {
+            return false;
+        }
+    }
+
+    if (g_timestamp_period_ns > 0.0f) {
+        VkQueryPoolCreateInfo queries = {};
+        queries.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+        queries.queryType = VK_QUERY_TYPE_TIMESTAMP;
+        queries.queryCount = GPU_TIMER_SLOTS * 2;
+        if (vkCreateQueryPool(g_device, &queries, nullptr, &g_timer_pool) != VK_SUCCESS) {
+            g_timer_pool = VK_NULL_HANDLE;
+        }
+    }
+    return true;
+}
+
+// Open a recording unless one is already open
+static VkCommandBuffer begin_commands() {
+    if (g_recording) return g_recording;
+
+    Recording& r = g_recordings[g_recording_next];
+    g_recording_slot = g_recording_next;
+    g_recording_next = (g_recording_next + 1) % COMMAND_RING_SIZE;
+    vkWaitForFences(g_device, 1, &r.fence, VK_TRUE, UINT64_MAX);
+    vkResetFences(g_device, 1, &r.fence);
+    vkResetCommandBuffer(r.commands, 0);
+    g_staging_used = 0;     // The slice's previous copies are done
+
+    VkCommandBufferBeginInfo info = {};
+    info.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+    info.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+    vkBeginCommandBuffer(r.commands, &info);
+    g_recording = r.commands;
+    reset_gpu_timers(g_recording);
+    return g_recording;
+}
+
+// Fence of the recording that owns the open command buffer
+static VkFence recording_fence(VkCommandBuffer cmd) {
+    for (const Recording& r : g_recordings) {
+        if (r.commands == cmd) return r.fence;
+    }
+    return VK_NULL_HANDLE;
+}
+
+bool backend_init(void* device_ptr, void* context_ptr) {
+    (void)device_ptr;
+    (void)context_ptr;
+    if (!create_instance() || !pick_physical_device() || !create_device() ||
+        !create_render_pass() || !create_pools()) {
+        backend_shutdown();
+        return false;
+    }
+
+    ImGui_ImplVulkan_InitInfo info = {};
+    info.Instance = g_instance;
+    info.PhysicalDevice = g_physical_device;
+    info.Device = g_device;
+    info.QueueFamily = g_queue_family;
+    info.Queue = g_queue;
+    info.DescriptorPool = g_descriptor_pool;
+    info.RenderPass = g_render_pass;
+    info.MinImageCount = 2;
+    info.ImageCount = COMMAND_RING_SIZE;
+    info.MSAASamples = VK_SAMPLE_COUNT_1_BIT;
+    g_imgui_ready = ImGui_ImplVulkan_Init(&info);
+    return g_imgui_ready;
+}
+
+bool backend_ready() {
+    return g_device != VK_NULL_HANDLE;
+}
+
+void backend_imgui_shutdown() {
+    if (!g_imgui_ready) return;
+    vkDeviceWaitIdle(g_device);
+    ImGui_ImplVulkan_Shutdown();
+    g_imgui_ready = false;
+}
+
+void backend_shutdown() {
+    if (g_device) {
+        vkDeviceWaitIdle(g_device);
+        destroy_staging_buffer();
+        for (Recording& r : g_recordings) {
+            if (r.fence) vkDestroyFence(g_device, r.fence, nullptr);
+            r = Recording();  // Command buffers go with their pool
+        }
+        if (g_command_pool) vkDestroyCommandPool(g_device, g_command_pool, nullptr);
+        if (g_descriptor_pool) vkDestroyDescriptorPool(g_device, g_descriptor_pool, nullptr);
+        if (g_render_pass) vkDestroyRenderPass(g_device, g_render_pass, nullptr);
+        vkDestroyDevice(g_device, nullptr);
+    }
+    if (g_instance) vkDestroyInstance(g_instance, nullptr);
+    g_command_pool = VK_NULL_HANDLE;
+    g_descriptor_pool = VK_NULL_HANDLE;
+    g_render_pass = VK_NULL_HANDLE;
+    g_device = VK_NULL_HANDLE;
+    g_instance = VK_NULL_HANDLE;
+    g_physical_device = VK_NULL_HANDLE;
+    g_queue = VK_NULL_HANDLE;
+    g_recording = VK_NULL_HANDLE;
+    g_submitted_fence = VK_NULL_HANDLE;
+    g_recording_next = 0;
+    g_in_render_pass = false;
+}
+
+void backend_new_frame() {
+    ImGui_ImplVulkan_NewFrame();
+}
+
+void backend_render_draw_data(ImDrawData* draw_data) {
+    ImGui_ImplVulkan_RenderDrawData(draw_data, begin_commands());
+}
+
+// The backend owns its queue, so any single thread may drive it
+bool backend_supports_render_thread() {
+    return true;
+}
+
+// ─────────────────────────── Render Targets ────────────────────────────
+struct BackendTarget {
+    VkImage image = VK_NULL_HANDLE;
+    VkDeviceMemory memory = VK_NULL_HANDLE;
+    VkImageView view = VK_NULL_HANDLE;         // Top mip level, the one rendered to
+    VkFramebuffer framebuffer = VK_NULL_HANDLE;
+    VkImageLayout layout = VK_IMAGE_LAYOUT_UNDEFINED;  // Of every level between renders
+    // Recording that last submitted the image. Ring fences get reused, so a
+    // reused one only ever reports the image busy for longer than it is.
+    VkFence fence = VK_NULL_HANDLE;
+};
+
+static bool find_memory_type(uint32_t type_bits, VkMemoryPropertyFlags flags, uint32_t* type_index) {
+    VkPhysicalDeviceMemoryProperties props;
+    vkGetPhysicalDeviceMemoryProperties(g_physical_device, &props);
+    for (uint32_t i = 0; i < props.memoryTypeCount; i++) {
+        if ((type_bits & (1u << i)) && (props.memoryTypes[i].propertyFlags & flags) == flags) {
+            *type_index = i;
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool find_device_local_memory(uint32_t type_bits, uint32_t* type_index) {
+    return find_memory_type(type_bits, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, type_index);
+}
+
+bool backend_create_target(RenderTarget* t) {
+    BackendTarget* native = new BackendTarget();
+    t->native = native;
+    if (!g_device) return false;
+
+    VkImageCreateInfo image = {};
+    image.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+    image.imageType = VK_IMAGE_TYPE_2D;
+    image.format = OVERLAY_TARGET_FORMAT;
+    image.extent = { t->width, t->height, 1 };
+    image.mipLevels = t->mip_levels;
+    image.arrayLayers = 1;
+    image.samples = VK_SAMPLE_COUNT_1_BIT;
+    image.tiling = VK_IMAGE_TILING_OPTIMAL;
+    // The compositor copies from the image, mips are blitted level to level
+    image.usage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT |
+                  VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+    image.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    image.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+    if (vkCreateImage(g_device, &image, nullptr, &native->image) != VK_SUCCESS) return false;
+
+    VkMemoryRequirements req;
+    vkGetImageMemoryRequirements(g_device, native->image, &req);
+    VkMemoryAllocateInfo alloc = {};
+    alloc.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    alloc.allocationSize = req.size;
+    if (!find_device_local_memory(req.memoryTypeBits, &alloc.memoryTypeIndex) ||
+        vkAllocateMemory(g_device, &alloc, nullptr, &native->memory) != VK_SUCCESS ||
+        vkBindImageMemory(g_device, native->image, native->memory, 0) != VK_SUCCESS) {
+        return false;
+    }
+
+    VkImageViewCreateInfo view = {};
+    view.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+    view.image = native->image;
+    view.viewType = VK_IMAGE_VIEW_TYPE_2D;
+    view.format = OVERLAY_TARGET_FORMAT;
+    view.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
+    if (vkCreateImageView(g_device, &view, nullptr, &native->view) != VK_SUCCESS) return false;
+
+    VkFramebufferCreateInfo fb = {};
+    fb.sType = VK_STRUCTURE_TYPE_FRAMEBUFFER_CREATE_INFO;
+    fb.renderPass = g_render_pass;
+    fb.attachmentCount = 1;
+    fb.pAttachments = &native->view;
+    fb.width = t->width;
+    fb.height = t->height;
+    fb.layers = 1;
+    return vkCreateFramebuffer(g_device, &fb, nullptr, &native->framebuffer) == VK_SUCCESS;
+}
+
+void backend_destroy_target(RenderTarget* t) {
+    BackendTarget* native = t->native;
+    if (!native) return;
+    // Idle targets may still be read by a recent recording; this only runs
+    // when the pool trims or is torn down
+    if (g_device) vkDeviceWaitIdle(g_device);
+    if (native->framebuffer) vkDestroyFramebuffer(g_device, native->framebuffer, nullptr);
+    if (native->view) vkDestroyImageView(g_device, native->view, nullptr);
+    if (native->image) vkDestroyImage(g_device, native->image, nullptr);
+    if (native->memory) vkFreeMemory(g_device, native->memory, nullptr);
+    delete native;
+    t->native = nullptr;
+}
+
+static void image_barrier(VkCommandBuffer cmd, VkImage image, uint32_t base_mip, uint32_t mip_count,
+                          VkImageLayout from, VkImageLayout to,
+                          VkAccessFlags src_access, VkAccessFlags dst_access,
+                          VkPipelineStageFlags src_stage, VkPipelineStageFlags dst_stage) {
+    VkImageMemoryBarrier barrier = {};
+    barrier.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER;
+    barrier.srcAccessMask = src_access;
+    barrier.dstAccessMask = dst_access;
+    barrier.oldLayout = from;
+    barrier.newLayout = to;
+    barrier.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED;
+    barrier.image = image;
+    barrier.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, base_mip, mip_count, 0, 1 };
+    vkCmdPipelineBarrier(cmd, src_stage, dst_stage, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+}
+
+void backend_bind_target(RenderTarget* t) {
+    VkCommandBuffer cmd = begin_commands();
+    BackendTarget* native = t->native;
+
+    // Level 0 keeps its pixels for partial redraws; a new image has none
+    image_barrier(cmd, native->image, 0, 1, native->layout, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+                  VK_ACCESS_TRANSFER_READ_BIT, VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
+                  VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT);
+
+    VkRenderPassBeginInfo info = {};
+    info.sType = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO;
+    info.renderPass = g_render_pass;
+    info.framebuffer = native->framebuffer;
+    info.renderArea.extent = { t->width, t->height };
+    vkCmdBeginRenderPass(cmd, &info, VK_SUBPASS_CONTENTS_INLINE);
+    g_in_render_pass = true;
+}
+
+bool backend_can_clear_rect() {
+    return true;
+}
+
+void backend_clear_target(RenderTarget* t, const float color[4], const TargetRect* rect) {
+    VkClearAttachment clear = {};
+    clear.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+    clear.colorAttachment = 0;
+    for (int i = 0; i < 4; i++) clear.clearValue.color.float32[i] = color[i];
+
+    VkClearRect area = {};
+    area.layerCount = 1;
+    if (rect) {
+        area.rect.offset = { rect->x0, rect->y0 };
+        area.rect.extent = { (uint32_t)(rect->x1 - rect->x0), (uint32_t)(rect->y1 - rect->y0) };
+    } else {
+        area.rect.extent = { t->width, t->height };
+    }
+    if (area.rect.extent.width == 0 || area.rect.extent.height == 0) return;
+    vkCmdClearAttachments(begin_commands(), 1, &clear, 1, &area);
+}
+
+// End the pass, fill the mip chain by halving blits and leave every level
+// ready for the compositor to copy from
+void backend_resolve_target(RenderTarget* t) {
+    if (!g_in_render_pass) return;
+    VkCommandBuffer cmd = begin_commands();
+    BackendTarget* native = t->native;
+    vkCmdEndRenderPass(cmd);
+    g_in_render_pass = false;
+
+    image_barrier(cmd, native->image, 0, 1, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL,
+                  VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                  VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT, VK_ACCESS_TRANSFER_READ_BIT,
+                  VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT);
+
+    int32_t w = (int32_t)t->width, h = (int32_t)t->height;
+    for (uint32_t level = 1; level < t->mip_levels; level++) {
+        int32_t next_w = w > 1 ? w / 2 : 1, next_h = h > 1 ? h / 2 : 1;
+        image_barrier(cmd, native->image, level, 1, VK_IMAGE_LAYOUT_UNDEFINED,
+                      VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 0, VK_ACCESS_TRANSFER_WRITE_BIT,
+                      VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT);
+
+        VkImageBlit blit = {};
+        blit.srcSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, level - 1, 0, 1 };
+        blit.srcOffsets[1] = { w, h, 1 };
+        blit.dstSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, level, 0, 1 };
+        blit.dstOffsets[1] = { next_w, next_h, 1 };
+        vkCmdBlitImage(cmd, native->image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                       native->image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &blit, VK_FILTER_LINEAR);
+
+        image_barrier(cmd, native->image, level, 1, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                      VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+                      VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_TRANSFER_READ_BIT,
+                      VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT);
+        w = next_w;
+        h = next_h;
+    }
+    native->layout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+}
+
+EVROverlayError backend_submit_target(VROverlayHandle_t handle, RenderTarget* t) {
+    if (g_in_render_pass) backend_resolve_target(t);
+    if (g_recording) {
+        VkCommandBuffer cmd = g_recording;
+        g_recording = VK_NULL_HANDLE;
+        vkEndCommandBuffer(cmd);
+
+        VkSubmitInfo submit = {};
+        submit.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+        submit.commandBufferCount = 1;
+        submit.pCommandBuffers = &cmd;
+        VkFence fence = recording_fence(cmd);
+        if (vkQueueSubmit(g_queue, 1, &submit, fence) != VK_SUCCESS) {
+            return VROverlayError_RequestFailed;
+        }
+        g_submitted_fence = fence;
+    }
+
+    VRVulkanTextureData_t vk_data = {};
+    vk_data.m_nImage = (uint64_t)t->native->image;
+    vk_data.m_pDevice = (VkDevice_T*)g_device;
+    vk_data.m_pPhysicalDevice = (VkPhysicalDevice_T*)g_physical_device;
+    vk_data.m_pInstance = (VkInstance_T*)g_instance;
+    vk_data.m_pQueue = (VkQueue_T*)g_queue;
+    vk_data.m_nQueueFamilyIndex = g_queue_family;
+    vk_data.m_nWidth = t->width;
+    vk_data.m_nHeight = t->height;
+    vk_data.m_nFormat = OVERLAY_TARGET_FORMAT;
+    vk_data.m_nSampleCount = 1;
+
+    Texture_t vr_tex = {};
+    vr_tex.handle = &vk_data;
+    vr_tex.eType = TextureType_Vulkan;
+    vr_tex.eColorSpace = ColorSpace_Gamma;
+    return VROverlay()->SetOverlayTexture(handle, &vr_tex);
+}
+
+// Submits already carry a fence; the target only remembers which one
+void backend_fence_target(RenderTarget* t) {
+    t->native->fence = g_submitted_fence;
+}
+
+bool backend_target_idle(RenderTarget* t) {
+    BackendTarget* native = t->native;
+    if (!native->fence) return true;
+    if (vkGetFenceStatus(g_device, native->fence) != VK_SUCCESS) return false;
+    native->fence = VK_NULL_HANDLE;
+    return true;
+}
+
+// ─────────────────────────── Textures ──────────────────────────────────
+struct BackendTexture {
+    VkImage image = VK_NULL_HANDLE;
+    VkDeviceMemory memory = VK_NULL_HANDLE;
+    VkImageView view = VK_NULL_HANDLE;
+    VkSampler sampler = VK_NULL_HANDLE;
+    VkDescriptorSet descriptor = VK_NULL_HANDLE;   // What ImGui samples it through
+};
+
+static bool create_staging_buffer() {
+    VkBufferCreateInfo info = {};
+    info.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+    info.size = STAGING_SLICE_SIZE * COMMAND_RING_SIZE;
+    info.usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+    info.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    if (vkCreateBuffer(g_device, &info, nullptr, &g_staging_buffer) != VK_SUCCESS) return false;
+
+    VkMemoryRequirements req;
+    vkGetBufferMemoryRequirements(g_device, g_staging_buffer, &req);
+    VkMemoryAllocateInfo alloc = {};
+    alloc.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    alloc.allocationSize = req.size;
+    void* mapped = nullptr;
+    if (!find_memory_type(req.memoryTypeBits,
+                          VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                          &alloc.memoryTypeIndex) ||
+        vkAllocateMemory(g_device, &alloc, nullptr, &g_staging_memory) != VK_SUCCESS ||
+        vkBindBufferMemory(g_device, g_staging_buffer, g_staging_memory, 0) != VK_SUCCESS ||
+        vkMapMemory(g_device, g_staging_memory, 0, info.size, 0, &mapped) != VK_SUCCESS) {
+        destroy_staging_buffer();
+        return false;
+    }
+    g_staging_mapped = (uint8_t*)mapped;
+    return true;
+}
+
+static void destroy_staging_buffer() {
+    if (g_staging_mapped) vkUnmapMemory(g_device, g_staging_memory);
+    if (g_staging_buffer) vkDestroyBuffer(g_device, g_staging_buffer, nullptr);
+    if (g_staging_memory) vkFreeMemory(g_device, g_staging_memory, nullptr);
+    g_staging_mapped = nullptr;
+    g_staging_buffer = VK_NULL_HANDLE;
+    g_staging_memory = VK_NULL_HANDLE;
+}
+
+BackendTexture* backend_create_texture(uint32_t width, uint32_t height) {
+    if (!g_device || !g_imgui_ready || g_in_render_pass) return nullptr;
+    if (!g_staging_buffer && !create_staging_buffer()) return nullptr;
+    BackendTexture* t = new BackendTexture();
+
+    VkImageCreateInfo image = {};
+    image.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO;
+    image.imageType = VK_IMAGE_TYPE_2D;
+    image.format = VK_FORMAT_R8G8B8A8_UNORM;
+    image.extent = { width, height, 1 };
+    image.mipLevels = 1;
+    image.arrayLayers = 1;
+    image.samples = VK_SAMPLE_COUNT_1_BIT;
+    image.tiling = VK_IMAGE_TILING_OPTIMAL;
+    image.usage = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT;
+    image.sharingMode = VK_SHARING_MODE_EXCLUSIVE;
+    image.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+    VkMemoryRequirements req = {};
+    VkMemoryAllocateInfo alloc = {};
+    alloc.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+    bool ok = vkCreateImage(g_device, &image, nullptr, &t->image) == VK_SUCCESS;
+    if (ok) {
+        vkGetImageMemoryRequirements(g_device, t->image, &req);
+        alloc.allocationSize = req.size;
+        ok = find_device_local_memory(req.memoryTypeBits, &alloc.memoryTypeIndex) &&
+             vkAllocateMemory(g_device, &alloc, nullptr, &t->memory) == VK_SUCCESS &&
+             vkBindImageMemory(g_device, t->image, t->memory, 0) == VK_SUCCESS;
+    }
+
+    VkImageViewCreateInfo view = {};
+    view.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
+    view.image = t->image;
+    view.viewType = VK_IMAGE_VIEW_TYPE_2D;
+    view.format = VK_FORMAT_R8G8B8A8_UNORM;
+    view.subresourceRange = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
+    ok = ok && vkCreateImageView(g_device, &view, nullptr, &t->view) == VK_SUCCESS;
+
+    VkSamplerCreateInfo sampler = {};
+    sampler.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
+    sampler.magFilter = VK_FILTER_LINEAR;
+    sampler.minFilter = VK_FILTER_LINEAR;
+    sampler.mipmapMode = VK_SAMPLER_MIPMAP_MODE_NEAREST;
+    sampler.addressModeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    sampler.addressModeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    sampler.addressModeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE;
+    sampler.maxLod = 1.0f;
+    ok = ok && vkCreateSampler(g_device, &sampler, nullptr, &t->sampler) == VK_SUCCESS;
+    if (!ok) {
+        backend_destroy_texture(t);
+        return nullptr;
+    }
+    t->descriptor = ImGui_ImplVulkan_AddTexture(t->sampler, t->view, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+
+    // Start out transparent and ready to sample
+    VkCommandBuffer cmd = begin_commands();
+    image_barrier(cmd, t->image, 0, 1, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                  0, VK_ACCESS_TRANSFER_WRITE_BIT,
+                  VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT);
+    VkClearColorValue transparent = {};
+    VkImageSubresourceRange range = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 1, 0, 1 };
+    vkCmdClearColorImage(cmd, t->image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, &transparent, 1, &range);
+    image_barrier(cmd, t->image, 0, 1, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                  VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                  VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT,
+                  VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT);
+    return t;
+}
+
+void backend_destroy_texture(BackendTexture* t) {
+    if (!t) return;
+    if (g_device) vkDeviceWaitIdle(g_device);
+    if (t->descriptor) ImGui_ImplVulkan_RemoveTexture(t->descriptor);
+    if (t->sampler) vkDestroySampler(g_device, t->sampler, nullptr);
+    if (t->view) vkDestroyImageView(g_device, t->view, nullptr);
+    if (t->image) vkDestroyImage(g_device, t->image, nullptr);
+    if (t->memory) vkFreeMemory(g_device, t->memory, nullptr);
+    delete t;
+}
+
+// Recorded into the open recording ahead of the frame's draws; the barriers
+// order the copy after earlier draws sampling the texture and before later ones
+bool backend_update_texture(BackendTexture* t, uint32_t x, uint32_t y,
+                            uint32_t width, uint32_t height, const uint8_t* rgba) {
+    if (g_in_render_pass) return false;
+    VkCommandBuffer cmd = begin_commands();
+    VkDeviceSize bytes = (VkDeviceSize)width * height * 4;
+    if (bytes > STAGING_SLICE_SIZE - g_staging_used) return false;
+
+    VkDeviceSize offset = STAGING_SLICE_SIZE * g_recording_slot + g_staging_used;
+    memcpy(g_staging_mapped + offset, rgba, (size_t)bytes);
+    g_staging_used += bytes;
+
+    image_barrier(cmd, t->image, 0, 1, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                  VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                  VK_ACCESS_SHADER_READ_BIT, VK_ACCESS_TRANSFER_WRITE_BIT,
+                  VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT);
+    VkBufferImageCopy region = {};
+    region.bufferOffset = offset;
+    region.imageSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1 };
+    region.imageOffset = { (int32_t)x, (int32_t)y, 0 };
+    region.imageExtent = { width, height, 1 };
+    vkCmdCopyBufferToImage(cmd, g_staging_buffer, t->image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+    image_barrier(cmd, t->image, 0, 1, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+                  VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL,
+                  VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_SHADER_READ_BIT,
+                  VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT);
+    return true;
+}
+
+ImTextureID backend_texture_id(BackendTexture* t) {
+    return (ImTextureID)t->descriptor;
+}
+
+// ─────────────────────────── GPU Timers ────────────────────────────────
+// Queries have to be reset outside a render pass before they are written
+// again, so read slots are reset at the start of a recording (or at a timer
+// begin outside the pass)
+static void reset_gpu_timers(VkCommandBuffer cmd) {
+    if (!g_timer_pool) return;
+    for (int slot = 0; slot < GPU_TIMER_SLOTS; slot++) {
+        if (g_timer_state[slot] != TIMER_NEEDS_RESET) continue;
+        vkCmdResetQueryPool(cmd, g_timer_pool, (uint32_t)slot * 2, 2);
+        g_timer_state[slot] = TIMER_READY;
+    }
+}
+
+bool backend_timer_begin(int slot) {
+    if (!g_timer_pool) return false;
+    VkCommandBuffer cmd = begin_commands();
+    if (!g_in_render_pass) reset_gpu_timers(cmd);
+    if (g_timer_state[slot] != TIMER_READY) return false;
+    vkCmdWriteTimestamp(cmd, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, g_timer_pool, (uint32_t)slot * 2);
+    g_timer_state[slot] = TIMER_WRITTEN;
+    return true;
+}
+
+void backend_timer_end(int slot) {
+    vkCmdWriteTimestamp(begin_commands(), VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, g_timer_pool,
+                        (uint32_t)slot * 2 + 1);
+}
+
+bool backend_timer_result(int slot, double* ms) {
+    uint64_t stamps[2] = {};
+    VkResult res = vkGetQueryPoolResults(g_device, g_timer_pool, (uint32_t)slot * 2, 2, sizeof(stamps),
+                                         stamps, sizeof(uint64_t), VK_QUERY_RESULT_64_BIT);
+    if (res != VK_SUCCESS) return false;
+    g_timer_state[slot] = TIMER_NEEDS_RESET;
+    *ms = stamps[1] >= stamps[0]
+        ? (double)(stamps[1] - stamps[0]) * (double)g_timestamp_period_ns / 1.0e6
+        : -1.0;
+    return true;
+}
+
+void backend_timer_destroy_all() {
+    if (g_timer_pool) vkDestroyQueryPool(g_device, g_timer_pool, nullptr);
+    g_timer_pool = VK_NULL_HANDLE;
+    for (TimerSlotState& state : g_timer_state) state = TIMER_NEEDS_RESET;
+}
@@ -1,16 +1,24 @@
 #include <openvr.h>
-#include <d3d11.h>
-#include <d3dcompiler.h>
 #include <vector>
+#include <algorithm>
+#include <deque>
+#include <unordered_map>
 #include <string>
 #include <cstring>
+#include <cstdio>
+#include <cstdlib>
+#include <cstddef>
+#include <cctype>
 #include <cfloat>
+#include <cmath>
+#include <chrono>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
 
 #include "imgui.h"
-#include "backends/imgui_impl_dx11.h"
-
-#pragma comment(lib, "d3d11.lib")
-#pragma comment(lib, "d3dcompiler.lib")
+#include "openvr_backend.h"
 
 using namespace vr;
 
@@ -35,49 +43,578 @@ struct ControllerState {
 };
 
 static ControllerState g_controllers[2]; // [0] = left, [1] = right
+static TrackedDevicePose_t g_device_poses[k_unMaxTrackedDeviceCount];  // Last fetched by vr_update_controllers
+
+
+// ─────────────────────────── Render Target Pool ─────────────────────────
+// Every overlay renders into targets taken from one pool keyed by size and
+// mip count. Each overlay's swapchain holds g_swapchain_buffers of them and
+// fences each one on submit. The next render goes to the least recently
+// submitted buffer whose fence has signalled; while the GPU still has every
+// buffer in flight the overlay skips that frame rather than stall the CPU
+// or draw into a texture still in use. When the size an overlay renders at
+// changes, its targets go back to the pool and ones of the new size are
+// taken, so an overlay never draws into a mis-sized target, and sizes used
+// before by any overlay are reused. The most recently released idle targets
+// are kept for that; older ones are freed.
+static const int MAX_SWAPCHAIN_BUFFERS = 4;
+static const size_t MAX_IDLE_RENDER_TARGETS = 4;
+static const uint32_t MAX_RENDER_TARGET_SIZE = 4096;
+static const float MAX_SUPERSAMPLE = 4.0f;
+
+// Optional quality mode per overlay (vr_overlay_set_quality): the UI is laid
+// out at the logical size but rasterized `supersample` times larger, then
+// filtered down a full mip chain, so text seen from a distance is sampled
+// from a stable pre-filtered level instead of shimmering.
+struct OverlayQuality {
+    float supersample = 1.0f;
+    bool mipmaps = false;
+};
+
+// RenderTarget itself is declared in openvr_backend.h
+static void destroy_render_target(RenderTarget* t) {
+    backend_destroy_target(t);
+    delete t;
+}
+
+static RenderTarget* create_render_target(uint32_t width, uint32_t height, uint32_t mip_levels) {
+    RenderTarget* t = new RenderTarget();
+    t->width = width;
+    t->height = height;
+    t->mip_levels = mip_levels;
+    if (!backend_create_target(t)) {
+        destroy_render_target(t);
+        return nullptr;
+    }
+    return t;
+}
+
+struct OverlaySwapchain {
+    RenderTarget* targets[MAX_SWAPCHAIN_BUFFERS] = {};
+    int count = 0;
+    int current = 0;
+    uint32_t width = 0;         // Logical size the UI is laid out at
+    uint32_t height = 0;
+    float scale = 1.0f;         // Target pixels per logical pixel
+    uint32_t mip_levels = 1;
+    uint32_t generation = 0;    // Bumped whenever the targets are replaced
+};
+
+static std::vector<RenderTarget*> g_render_targets;
+static uint64_t g_render_target_releases = 0;
+static std::atomic<int> g_swapchain_buffers{2};   // Set from Rust, applied on the next render
+
+static OverlaySwapchain g_hud_swapchain;
+static OverlaySwapchain g_dashboard_swapchain;
+static OverlaySwapchain g_keyboard_swapchain;
+
+static RenderTarget* acquire_render_target(uint32_t width, uint32_t height, uint32_t mip_levels) {
+    for (RenderTarget* t : g_render_targets) {
+        if (!t->in_use && t->width == width && t->height == height && t->mip_levels == mip_levels) {
+            t->in_use = true;
+            return t;
+        }
+    }
+
+    RenderTarget* t = create_render_target(width, height, mip_levels);
+    if (!t) return nullptr;
+    t->in_use = true;
+    g_render_targets.push_back(t);
+    return t;
+}
+
+static void release_render_target(RenderTarget* target) {
+    target->in_use = false;
+    target->released_at = ++g_render_target_releases;
+
+    size_t idle = 0;
+    for (RenderTarget* t : g_render_targets) idle += t->in_use ? 0 : 1;
+    while (idle > MAX_IDLE_RENDER_TARGETS) {
+        size_t oldest = SIZE_MAX;
+        for (size_t i = 0; i < g_render_targets.size(); i++) {
+            const RenderTarget* t = g_render_targets[i];
+            if (!t->in_use && (oldest == SIZE_MAX || t->released_at < g_render_targets[oldest]->released_at)) {
+                oldest = i;
+            }
+        }
+        destroy_render_target(g_render_targets[oldest]);
+        g_render_targets.erase(g_render_targets.begin() + oldest);
+        idle--;
+    }
+}
+
+static void swapchain_release(OverlaySwapchain& sc) {
+    for (int i = 0; i < sc.count; i++) {
+        release_render_target(sc.targets[i]);
+        sc.targets[i] = nullptr;
+    }
+    sc.count = 0;
+    sc.current = 0;
+    sc.width = 0;
+    sc.height = 0;
+}
+
+static uint32_t full_mip_count(uint32_t width, uint32_t height) {
+    uint32_t size = width > height ? width : height;
+    uint32_t levels = 1;
+    while (size >>= 1) levels++;
+    return levels;
+}
 
+// Make sure the swapchain holds targets for this logical size and quality,
+// swapping them through the pool if not. False if the size is invalid or
+// targets can't be created.
+static bool swapchain_acquire(OverlaySwapchain& sc, uint32_t width, uint32_t height,
+                              const OverlayQuality& quality) {
+    if (width == 0 || height == 0 || width > MAX_RENDER_TARGET_SIZE || height > MAX_RENDER_TARGET_SIZE) {
+        return false;
+    }
+    int count = g_swapchain_buffers.load(std::memory_order_relaxed);
+    if (count < 1) count = 1;
+    if (count > MAX_SWAPCHAIN_BUFFERS) count = MAX_SWAPCHAIN_BUFFERS;
+
+    // Supersampling is capped so the target stays within the size limit
+    float scale = fminf(fmaxf(quality.supersample, 1.0f), MAX_SUPERSAMPLE);
+    uint32_t largest = width > height ? width : height;
+    scale = fminf(scale, (float)MAX_RENDER_TARGET_SIZE / (float)largest);
+    uint32_t target_width = (uint32_t)ceilf(width * scale);
+    uint32_t target_height = (uint32_t)ceilf(height * scale);
+    uint32_t mip_levels = quality.mipmaps ? full_mip_count(target_width, target_height) : 1;
+
+    if (sc.count == count && sc.width == width && sc.height == height &&
+        sc.scale == scale && sc.mip_levels == mip_levels) {
+        return true;
+    }
 
-// ─────────────────────────── D3D11 State ───────────────────────────────
-static ID3D11Device*           g_device        = nullptr;
-static ID3D11DeviceContext*    g_context       = nullptr;
+    swapchain_release(sc);
+    for (int i = 0; i < count; i++) {
+        sc.targets[i] = acquire_render_target(target_width, target_height, mip_levels);
+        if (!sc.targets[i]) {
+            sc.count = i;
+            swapchain_release(sc);
+            return false;
+        }
+    }
+    sc.count = count;
+    sc.width = width;
+    sc.height = height;
+    sc.scale = scale;
+    sc.mip_levels = mip_levels;
+    sc.generation++;
+    return true;
+}
 
-// HUD overlay resources
-static ID3D11Texture2D*        g_textures[2]   = {nullptr, nullptr};
-static ID3D11RenderTargetView* g_rtvs[2]       = {nullptr, nullptr};
-static ID3D11ShaderResourceView* g_srvs[2]     = {nullptr, nullptr};
-static int                     g_current_tex   = 0;
+// Buffer to render into next, made current; null while all are in flight
+static RenderTarget* swapchain_target(OverlaySwapchain& sc) {
+    for (int i = 0; i < sc.count; i++) {
+        int b = (sc.current + i) % sc.count;
+        if (backend_target_idle(sc.targets[b])) {
+            sc.current = b;
+            return sc.targets[b];
+        }
+    }
+    return nullptr;
+}
 
-// Dashboard overlay resources
-static ID3D11Texture2D*        g_dashboard_textures[2] = {nullptr, nullptr};
-static ID3D11RenderTargetView* g_dashboard_rtvs[2]     = {nullptr, nullptr};
-static ID3D11ShaderResourceView* g_dashboard_srvs[2]   = {nullptr, nullptr};
-static int                     g_dashboard_current_tex  = 0;
+static void swapchain_advance(OverlaySwapchain& sc) {
+    backend_fence_target(sc.targets[sc.current]);
+    sc.current = (sc.current + 1) % sc.count;
+}
+
+// Stretch draw data laid out at the logical size over a supersampled target
+static void scale_draw_data(ImDrawData* draw_data, float scale) {
+    if (scale == 1.0f) return;
+    for (int n = 0; n < draw_data->CmdListsCount; n++) {
+        ImDrawList* dl = draw_data->CmdLists[n];
+        for (int i = 0; i < dl->VtxBuffer.Size; i++) {
+            dl->VtxBuffer[i].pos.x *= scale;
+            dl->VtxBuffer[i].pos.y *= scale;
+        }
+        for (int i = 0; i < dl->CmdBuffer.Size; i++) {
+            ImVec4& clip = dl->CmdBuffer[i].ClipRect;
+            clip = ImVec4(clip.x * scale, clip.y * scale, clip.z * scale, clip.w * scale);
+        }
+    }
+    draw_data->DisplayPos = ImVec2(draw_data->DisplayPos.x * scale, draw_data->DisplayPos.y * scale);
+    draw_data->DisplaySize = ImVec2(draw_data->DisplaySize.x * scale, draw_data->DisplaySize.y * scale);
+}
 
-// Keyboard overlay resources
-static ID3D11Texture2D*        g_keyboard_textures[2] = {nullptr, nullptr};
-static ID3D11RenderTargetView* g_keyboard_rtvs[2]     = {nullptr, nullptr};
-static ImGuiContext*           g_keyboard_imgui_ctx   = nullptr;
-static int                     g_keyboard_current_tex  = 0;
+// ─────────────────────────── Damage Tracking ────────────────────────────
+// With damage tracking the HUD keeps its texture contents between renders
+// and only re-rasterizes what changed. The UI is still built every render,
+// but its draw lists are diffed against the previous render's: everything
+// drawn from the first changed vertex, index or command onwards, old and new,
+// bounds the damage. Only that rect is cleared and every draw command is
+// clipped to it, so GPU cost follows what changed (a new chat line, the laser
+// dot, the caret) rather than the overlay area. Each swapchain buffer collects
+// the damage it missed while the others were drawn.
+struct DamageRect {
+    float x0 = FLT_MAX, y0 = FLT_MAX;
+    float x1 = -FLT_MAX, y1 = -FLT_MAX;
+
+    bool empty() const { return x0 >= x1 || y0 >= y1; }
+    void add(float x, float y) {
+        x0 = fminf(x0, x); y0 = fminf(y0, y);
+        x1 = fmaxf(x1, x); y1 = fmaxf(y1, y);
+    }
+    void add(const DamageRect& r) {
+        if (r.empty()) return;
+        add(r.x0, r.y0);
+        add(r.x1, r.y1);
+    }
+};
+
+struct DrawListCopy {
+    std::vector<ImDrawVert> vtx;
+    std::vector<ImDrawIdx> idx;
+    std::vector<ImDrawCmd> cmd;
+};
+
+struct DamageState {
+    std::vector<DrawListCopy> previous;
+    bool valid = false;                         // previous holds the last render
+    uint32_t swapchain_generation = 0;
+    DamageRect pending[MAX_SWAPCHAIN_BUFFERS];  // Per buffer, not yet redrawn there
+};
+
+static std::atomic<bool> g_damage_tracking{true};
+static DamageState g_hud_damage;
+
+static bool can_clear_region() {
+    return backend_can_clear_rect();
+}
+
+// Clear the whole target, or only `region` (logical pixels) of it. Rounds
+// the same way ImGui backends do for scissor rects.
+static void clear_render_target(RenderTarget* t, const float color[4], const DamageRect* region,
+                                float scale) {
+    if (!region) {
+        backend_clear_target(t, color, nullptr);
+        return;
+    }
+    TargetRect rect = { (int32_t)(region->x0 * scale), (int32_t)(region->y0 * scale),
+                        (int32_t)(region->x1 * scale), (int32_t)(region->y1 * scale) };
+    backend_clear_target(t, color, &rect);
+}
+
+static bool same_draw_cmd(const ImDrawCmd& a, const ImDrawCmd& b) {
+    return memcmp(&a.ClipRect, &b.ClipRect, sizeof(ImVec4)) == 0 &&
+           a.TextureId == b.TextureId && a.VtxOffset == b.VtxOffset &&
+           a.IdxOffset == b.IdxOffset && a.ElemCount == b.ElemCount &&
+           a.UserCallback == b.UserCallback && a.UserCallbackData == b.UserCallbackData;
+}
+
+// Lowest vertex used by any index from `from` on
+static size_t lowest_vertex_from(const ImDrawCmd* cmds, size_t cmd_count,
+                                 const ImDrawIdx* idx, size_t from) {
+    size_t lowest = SIZE_MAX;
+    for (size_t c = 0; c < cmd_count; c++) {
+        size_t begin = cmds[c].IdxOffset;
+        size_t end = begin + cmds[c].ElemCount;
+        for (size_t k = begin > from ? begin : from; k < end; k++) {
+            size_t vtx = (size_t)idx[k] + cmds[c].VtxOffset;
+            if (vtx < lowest) lowest = vtx;
+        }
+    }
+    return lowest;
+}
+
+static void add_vertex_bounds(DamageRect& r, const ImDrawVert* vtx, size_t from, size_t count) {
+    for (size_t k = from; k < count; k++) r.add(vtx[k].pos.x, vtx[k].pos.y);
+}
+
+static void diff_draw_list(const DrawListCopy& old, const ImDrawList* dl, DamageRect& out) {
+    const size_t old_vtx = old.vtx.size(), new_vtx = (size_t)dl->VtxBuffer.Size;
+    const size_t old_idx = old.idx.size(), new_idx = (size_t)dl->IdxBuffer.Size;
+    const size_t old_cmd = old.cmd.size(), new_cmd = (size_t)dl->CmdBuffer.Size;
+
+    // Length of the unchanged prefix of each buffer
+    size_t v = 0;
+    while (v < old_vtx && v < new_vtx &&
+           memcmp(&old.vtx[v], &dl->VtxBuffer.Data[v], sizeof(ImDrawVert)) == 0) v++;
+    size_t i = 0;
+    while (i < old_idx && i < new_idx && old.idx[i] == dl->IdxBuffer.Data[i]) i++;
+    size_t c = 0;
+    while (c < old_cmd && c < new_cmd && same_draw_cmd(old.cmd[c], dl->CmdBuffer.Data[c])) c++;
+    if (v == old_vtx && v == new_vtx && i == old_idx && i == new_idx && c == old_cmd && c == new_cmd) {
+        return;
+    }
+
+    // Triangles from the first changed index or command on may be built
+    // from unchanged vertices, so those count as damaged too
+    size_t first_idx = i;
+    if (c < old_cmd && old.cmd[c].IdxOffset < first_idx) first_idx = old.cmd[c].IdxOffset;
+    if (c < new_cmd && dl->CmdBuffer.Data[c].IdxOffset < first_idx) first_idx = dl->CmdBuffer.Data[c].IdxOffset;
+    size_t lowest = lowest_vertex_from(old.cmd.data(), old_cmd, old.idx.data(), first_idx);
+    if (lowest < v) v = lowest;
+    lowest = lowest_vertex_from(dl->CmdBuffer.Data, new_cmd, dl->IdxBuffer.Data, first_idx);
+    if (lowest < v) v = lowest;
+
+    add_vertex_bounds(out, old.vtx.data(), v, old_vtx);
+    add_vertex_bounds(out, dl->VtxBuffer.Data, v, new_vtx);
+}
+
+static void copy_draw_data(std::vector<DrawListCopy>& copy, const ImDrawData* dd) {
+    copy.resize(dd->CmdListsCount);
+    for (int n = 0; n < dd->CmdListsCount; n++) {
+        const ImDrawList* dl = dd->CmdLists[n];
+        copy[n].vtx.assign(dl->VtxBuffer.Data, dl->VtxBuffer.Data + dl->VtxBuffer.Size);
+        copy[n].idx.assign(dl->IdxBuffer.Data, dl->IdxBuffer.Data + dl->IdxBuffer.Size);
+        copy[n].cmd.assign(dl->CmdBuffer.Data, dl->CmdBuffer.Data + dl->CmdBuffer.Size);
+    }
+}
+
+// Work out what the swapchain's current buffer has to redraw. Returns false
+// when the whole target must be redrawn; otherwise `region` (logical
+// pixels, snapped outwards, possibly empty) is the part to redraw.
+static bool take_damage(DamageState& st, const OverlaySwapchain& sc, const ImDrawData* dd,
+                        DamageRect& region) {
+    if (!g_damage_tracking.load(std::memory_order_relaxed) || !can_clear_region()) {
+        st.valid = false;
+        return false;
+    }
+
+    DamageRect frame;
+    bool full = !st.valid || st.swapchain_generation != sc.generation ||
+                st.previous.size() != (size_t)dd->CmdListsCount;
+    if (!full) {
+        for (int n = 0; n < dd->CmdListsCount; n++) diff_draw_list(st.previous[n], dd->CmdLists[n], frame);
+    }
+    copy_draw_data(st.previous, dd);
+    st.valid = true;
+    st.swapchain_generation = sc.generation;
+
+    if (full) {
+        // The other buffers still hold older frames
+        DamageRect all;
+        all.add(0.0f, 0.0f);
+        all.add((float)sc.width, (float)sc.height);
+        for (int b = 0; b < MAX_SWAPCHAIN_BUFFERS; b++) st.pending[b] = all;
+        st.pending[sc.current] = DamageRect();
+        return false;
+    }
+
+    for (int b = 0; b < sc.count; b++) st.pending[b].add(frame);
+    region = st.pending[sc.current];
+    st.pending[sc.current] = DamageRect();
+    if (region.empty()) return true;
+
+    // One pixel of slack for antialiasing fringes, then whole pixels
+    region.x0 = fmaxf(floorf(region.x0) - 1.0f, 0.0f);
+    region.y0 = fmaxf(floorf(region.y0) - 1.0f, 0.0f);
+    region.x1 = fminf(ceilf(region.x1) + 1.0f, (float)sc.width);
+    region.y1 = fminf(ceilf(region.y1) + 1.0f, (float)sc.height);
+    return true;
+}
+
+// Restrict every draw command to the damaged region
+static void clip_draw_data(ImDrawData* dd, const DamageRect& region) {
+    for (int n = 0; n < dd->CmdListsCount; n++) {
+        ImDrawList* dl = dd->CmdLists[n];
+        for (int i = 0; i < dl->CmdBuffer.Size; i++) {
+            ImVec4& clip = dl->CmdBuffer.Data[i].ClipRect;
+            clip.x = fmaxf(clip.x, region.x0);
+            clip.y = fmaxf(clip.y, region.y0);
+            clip.z = fmaxf(fminf(clip.z, region.x1), clip.x);
+            clip.w = fmaxf(fminf(clip.w, region.y1), clip.y);
+        }
+    }
+}
+
+extern "C" void vr_set_damage_tracking(bool enabled) {
+    g_damage_tracking.store(enabled, std::memory_order_relaxed);
+}
+
+static void destroy_render_target_pool() {
+    swapchain_release(g_hud_swapchain);
+    swapchain_release(g_dashboard_swapchain);
+    swapchain_release(g_keyboard_swapchain);
+    for (RenderTarget* t : g_render_targets) destroy_render_target(t);
+    g_render_targets.clear();
+}
+
+// Buffers per overlay swapchain (1-4); takes effect on each overlay's next render
+extern "C" void vr_set_swapchain_buffers(int count) {
+    g_swapchain_buffers.store(count, std::memory_order_relaxed);
+}
+
+// The keyboard shares g_imgui_ctx; it only owns a draw list. The font atlas
+// and texture id only exist once the main context has run a frame.
+static const float KEYBOARD_WIDTH = 512.0f;
+static const float KEYBOARD_HEIGHT = 384.0f;
+static const float KEYBOARD_UI_SCALE = 2.0f;  // Larger for VR
+static ImDrawList* g_keyboard_draw_list = nullptr;
+static bool g_imgui_frame_ready = false;
 
 // ─────────────────────────── ImGui State ───────────────────────────────
 static ImGuiContext* g_imgui_ctx = nullptr;
-static float g_mouse_x = 0;
+static float g_mouse_x = 0;         // HUD pointer, from the input snapshot
 static float g_mouse_y = 0;
 static bool g_mouse_down = false;
 
+// Pointer of an overlay driven by compositor mouse events
+struct OverlayPointer {
+    float x = 0.0f;
+    float y = 0.0f;
+    bool down = false;
+};
+
+static OverlayPointer g_dashboard_pointer;   // Render side
+
 static bool g_input_focused = false;
-static bool g_input_just_focused = false;
+static std::atomic<bool> g_input_just_focused{false};  // Read and cleared by Rust
 static double g_last_cursor_blink_time = 0.0;
 static bool g_cursor_visible = true;
+
+// ─────────────────────────── ImGui Heap ────────────────────────────────
+// ImGui allocates through the functions installed here. Its buffers outlive
+// the frame that grew them (draw lists, windows, the font atlas), so a
+// per-frame bump arena can't back them; instead a freed block goes on the
+// free list of its power-of-two size class and the next request of that
+// class takes it back. Once the UI's buffers have reached their working
+// sizes a frame asks the system heap for nothing, and so never contends with
+// the gRPC threads for malloc's locks. Only the render side uses ImGui (see
+// Render Thread), so the pool takes no lock; the counters are read from
+// either thread. Pooled blocks are kept until exit.
+static const int IMGUI_HEAP_CLASSES = 15;              // 16 bytes to 256 KiB
+static const size_t IMGUI_HEAP_MIN_BLOCK = 16;
+
+union ImGuiHeapHeader {
+    ImGuiHeapHeader* next;     // While on a free list
+    int size_class;            // While handed out; IMGUI_HEAP_CLASSES = unpooled
+    std::max_align_t align;
+};
+
+static ImGuiHeapHeader* g_imgui_heap_free[IMGUI_HEAP_CLASSES] = {};
+static std::atomic<uint64_t> g_imgui_allocations{0};       // Every ImGui request
+static std::atomic<uint64_t> g_imgui_allocated_bytes{0};
+static std::atomic<uint64_t> g_imgui_heap_allocations{0};  // Requests the pool couldn't serve
+
+static void* imgui_heap_alloc(size_t size, void*) {
+    g_imgui_allocations.fetch_add(1, std::memory_order_relaxed);
+    g_imgui_allocated_bytes.fetch_add(size, std::memory_order_relaxed);
+
+    int size_class = 0;
+    size_t block_size = IMGUI_HEAP_MIN_BLOCK;
+    while (block_size < size && size_class < IMGUI_HEAP_CLASSES) {
+        block_size <<= 1;
+        size_class++;
+    }
+
+    ImGuiHeapHeader* block;
+    if (size_class < IMGUI_HEAP_CLASSES && g_imgui_heap_free[size_class]) {
+        block = g_imgui_heap_free[size_class];
+        g_imgui_heap_free[size_class] = block->next;
+    } else {
+        size_t bytes = size_class < IMGUI_HEAP_CLASSES ? block_size : size;
+        block = (ImGuiHeapHeader*)malloc(sizeof(ImGuiHeapHeader) + bytes);
+        if (!block) return nullptr;
+        g_imgui_heap_allocations.fetch_add(1, std::memory_order_relaxed);
+    }
+    block->size_class = size_class;
+    return block + 1;
+}
+
+static void imgui_heap_free(void* ptr, void*) {
+    if (!ptr) return;
+    ImGuiHeapHeader* block = (ImGuiHeapHeader*)ptr - 1;
+    int size_class = block->size_class;
+    if (size_class >= IMGUI_HEAP_CLASSES) {
+        free(block);
+        return;
+    }
+    block->next = g_imgui_heap_free[size_class];
+    g_imgui_heap_free[size_class] = block;
+}
+
+// Before creating a context; memory ImGui holds must come from one allocator
+static void install_imgui_heap() {
+    ImGui::SetAllocatorFunctions(imgui_heap_alloc, imgui_heap_free);
+}
 // ─────────────────────────── Chat State ─────────────────────────────────
-struct ChatMessage {
-    char author[64];
-    char text[256];
+// Packed FFI layout (imgui_chat_append_packed): one byte arena holding every
+// string of the batch, plus a record per message pointing into it. Authors
+// are interned by the sender, so repeat chatters share one copy.
+struct ChatRecordFFI {
+    uint32_t author_offset;
+    uint32_t author_len;
+    uint32_t text_offset;
+    uint32_t text_len;
 };
 
-static std::vector<ChatMessage> g_chat_messages;
+// Scrollback lives in a chunked byte arena owned by the native side. Text is
+// copied in as variable-length, NUL-terminated UTF-8 and indexed by
+// g_chat_entries; author names are interned in g_chat_authors and refcounted
+// by the entries that use them. Once the byte budget is reached the oldest chunk is
+// dropped together with every message stored in it, so history is bounded by
+// memory rather than by a message count. g_chat_seq counts every message ever
+// appended; message ids are consecutive, so an id maps straight to an index.
+static const size_t CHAT_CHUNK_SIZE = 64 * 1024;
+static const size_t CHAT_DEFAULT_HISTORY_BYTES = 8 * 1024 * 1024;
+
+struct ChatChunk {
+    std::vector<char> data;
+    size_t used;
+    uint64_t serial;
+};
+
+typedef std::unordered_map<std::string, uint32_t> ChatAuthorTable;
+
+struct ChatEntry {
+    uint64_t id;
+    uint64_t chunk_serial;    // Chunk holding the text
+    ChatAuthorTable::value_type* author_ref;
+    const char* author;
+    const char* text;
+    uint32_t author_len;
+    uint32_t text_len;
+    uint32_t line_count;      // Lines in g_chat_lines once laid out
+    float author_width;       // "author:" plus the SameLine spacing
+    bool has_emotes;          // Laid out and drawn word by word; see Emote Atlas
+};
+
+static std::deque<ChatChunk> g_chat_chunks;
+static uint64_t g_chat_next_chunk_serial = 0;
+static size_t g_chat_arena_bytes = 0;
+static size_t g_chat_max_bytes = CHAT_DEFAULT_HISTORY_BYTES;
+static std::deque<ChatEntry> g_chat_entries;
+static ChatAuthorTable g_chat_authors;
+static uint64_t g_chat_seq = 0;
+
+// Chat posted from Rust is queued in g_chat_inbox and moved into the
+// scrollback by the render side at the start of its next frame, so posting
+// never waits for a UI build and only the render side touches the arena.
+// g_chat_posted_seq is the sender's view of g_chat_seq.
+struct ChatInbox {
+    std::vector<char> bytes;
+    std::vector<ChatRecordFFI> records;
+    bool clear = false;           // Drop the history before adding records
+    size_t history_budget = 0;    // 0 = unchanged
+};
+
+static std::mutex g_chat_inbox_mutex;
+static ChatInbox g_chat_inbox;           // Guarded by g_chat_inbox_mutex
+static uint64_t g_chat_posted_seq = 0;   // Guarded by g_chat_inbox_mutex
+static ChatInbox g_chat_inbox_drain;     // Render side only
+
+// ─────────────────────────── Chat Layout Cache ──────────────────────────
+// Chat text never changes once received, so each message is wrapped once when
+// it first reaches the chat list and its lines are appended to g_chat_lines.
+// Everything is re-wrapped only when the wrap width or font size changes, and
+// the list only emits the lines that are actually visible, so the per-frame
+// cost does not grow with the size of the history.
+struct ChatVisualLine {
+    uint64_t message_id;
+    uint32_t begin;   // Byte range within the message text
+    uint32_t end;
+};
+
+static std::deque<ChatVisualLine> g_chat_lines;
+static size_t g_chat_laid_out = 0;        // Leading entries already in g_chat_lines
+static size_t g_chat_evicted_lines = 0;   // Lines dropped since the chat list last drew
+static float g_chat_lines_wrap_width = -1.0f;
+static float g_chat_lines_font_size = 0.0f;
 static char g_input_buffer[256] = {0};
-static bool g_message_sent = false;
 
 // ─────────────────────────── Dashboard/Settings State ───────────────────
 struct OverlaySettingsFFI {
@@ -108,7 +645,38 @@ static OverlaySettingsFFI g_overlay_settings = {
 };
 
 static DashboardState g_dashboard_state = {false, 0};
-static bool g_dashboard_state_changed = false;
+
+// Mirrors of show_alerts and alert_duration for the input side, which
+// animates alerts
+static std::atomic<bool> g_alerts_enabled{true};
+static std::atomic<float> g_alert_duration{5.0f};
+
+static void publish_alert_settings() {
+    g_alerts_enabled.store(g_overlay_settings.show_alerts, std::memory_order_relaxed);
+    g_alert_duration.store(g_overlay_settings.alert_duration, std::memory_order_relaxed);
+}
+
+// Values handed back to Rust (imgui_get_sent_message,
+// imgui_get_dashboard_state). The UI may run on the render thread, so it
+// posts copies here instead of Rust reading the widget state directly.
+static std::mutex g_outbox_mutex;
+static char g_sent_message[256] = {0};              // Guarded by g_outbox_mutex
+static bool g_message_sent = false;                 // Guarded by g_outbox_mutex
+static DashboardState g_dashboard_outbox = {false, 0};  // Guarded by g_outbox_mutex
+static bool g_dashboard_state_changed = false;      // Guarded by g_outbox_mutex
+
+static void post_sent_message(const char* text) {
+    std::lock_guard<std::mutex> lock(g_outbox_mutex);
+    strncpy(g_sent_message, text, sizeof(g_sent_message) - 1);
+    g_sent_message[sizeof(g_sent_message) - 1] = 0;
+    g_message_sent = true;
+}
+
+static void post_dashboard_state() {
+    std::lock_guard<std::mutex> lock(g_outbox_mutex);
+    g_dashboard_outbox = g_dashboard_state;
+    g_dashboard_state_changed = true;
+}
 
 // ─────────────────────────── Laser Hit Info ────────────────────────────
 struct LaserPointerState {
@@ -116,23 +684,1156 @@ struct LaserPointerState {
     float x, y;
 };
 
-static LaserPointerState g_laser_states[2] = {{false, 0, 0}, {false, 0, 0}};
+static LaserPointerState g_laser_states[2] = {{false, 0, 0}, {false, 0, 0}};
+
+// Laser dots are separate overlays (see Laser Cursors) unless turned off
+static std::atomic<bool> g_cursor_overlays{true};
+
+struct LaserHit {
+    bool hit;
+    float u, v;
+    float distance;
+};
+
+// ─────────────────────────── Retained Rendering ─────────────────────────
+// Anything that can change what an overlay shows bumps its generation. When
+// the generation matches the last rendered one the render call returns
+// early: no ImGui frame, no draw, no SetOverlayTexture, and the compositor
+// keeps showing the last submitted texture.
+struct RetainedState {
+    std::atomic<uint64_t> generation{1};   // Bumped from either thread
+    uint64_t rendered_generation = 0;
+    int settle_frames = 0;
+};
+
+// ImGui applies some changes (hover, auto-scroll, focus) one frame late, so
+// keep rendering briefly after the last change before going idle.
+static const int RETAINED_SETTLE_FRAMES = 2;
+
+static std::atomic<bool> g_retained_mode{true};
+static RetainedState g_hud_retained;
+static RetainedState g_dashboard_retained;
+static RetainedState g_keyboard_retained;
+
+static void mark_dirty(RetainedState& state) {
+    state.generation++;
+}
+
+static bool needs_render(RetainedState& state) {
+    if (!g_retained_mode) return true;
+
+    uint64_t generation = state.generation.load(std::memory_order_acquire);
+    if (generation != state.rendered_generation) {
+        state.rendered_generation = generation;
+        state.settle_frames = RETAINED_SETTLE_FRAMES;
+        return true;
+    }
+    if (state.settle_frames > 0) {
+        state.settle_frames--;
+        return true;
+    }
+    return false;
+}
+
+// ─────────────────────────── Input Snapshot ─────────────────────────────
+// Pointer, laser, settings and dashboard state posted from Rust land in a
+// writer-side staging copy. imgui_publish_input() hands that copy to the
+// render side through a triple buffer: publishing never waits for the
+// reader, and each render call picks up the newest complete snapshot, so a
+// frame never sees half of an update. The render side keeps its own working
+// state (g_mouse_x, g_laser_states, ...) since UI widgets edit it too.
+struct InputSnapshot {
+    float mouse_x = 0.0f;
+    float mouse_y = 0.0f;
+    bool mouse_down = false;
+    LaserPointerState lasers[2] = {{false, 0, 0}, {false, 0, 0}};
+    bool has_settings = false;    // Rust has posted settings at least once
+    OverlaySettingsFFI settings;
+    bool has_dashboard = false;
+    DashboardState dashboard = {false, 0};
+    // Keyboard to draw on the render thread (vr_keyboard_post)
+    VROverlayHandle_t keyboard_handle = k_ulOverlayHandleInvalid;  // Invalid while hidden
+    float keyboard_selected_x = -1.0f;
+    float keyboard_selected_y = -1.0f;
+    char keyboard_text[256] = {0};
+};
+
+static const uint32_t INPUT_SLOT_MASK = 3;
+static const uint32_t INPUT_FRESH = 4;   // Middle slot holds an unread snapshot
+
+static InputSnapshot g_input_staging;                   // Writer only
+static InputSnapshot g_input_slots[3];
+static uint32_t g_input_back = 0;                       // Writer only
+static std::atomic<uint32_t> g_input_middle{1};
+static uint32_t g_input_front = 2;                      // Reader only
+static InputSnapshot g_input_applied;                   // Reader only
+
+// Each publish wakes the render thread, when one is running
+static std::atomic<bool> g_render_thread_running{false};
+static std::mutex g_render_kick_mutex;
+static std::condition_variable g_render_kick_cv;
+static bool g_render_kicked = false;                    // Guarded by g_render_kick_mutex
+
+extern "C" void imgui_publish_input() {
+    g_input_slots[g_input_back] = g_input_staging;
+    uint32_t prev = g_input_middle.exchange(g_input_back | INPUT_FRESH, std::memory_order_acq_rel);
+    g_input_back = prev & INPUT_SLOT_MASK;
+
+    if (g_render_thread_running.load(std::memory_order_acquire)) {
+        {
+            std::lock_guard<std::mutex> lock(g_render_kick_mutex);
+            g_render_kicked = true;
+        }
+        g_render_kick_cv.notify_one();
+    }
+}
+
+// Apply the newest published snapshot, marking overlays dirty only for
+// values that actually changed since the last one applied
+static void apply_input_snapshot() {
+    if (!(g_input_middle.load(std::memory_order_acquire) & INPUT_FRESH)) return;
+    uint32_t prev = g_input_middle.exchange(g_input_front, std::memory_order_acq_rel);
+    g_input_front = prev & INPUT_SLOT_MASK;
+
+    const InputSnapshot& in = g_input_slots[g_input_front];
+    InputSnapshot& last = g_input_applied;
+
+    if (in.mouse_x != last.mouse_x || in.mouse_y != last.mouse_y ||
+        in.mouse_down != last.mouse_down) {
+        mark_dirty(g_hud_retained);
+    }
+    g_mouse_x = in.mouse_x;
+    g_mouse_y = in.mouse_y;
+    g_mouse_down = in.mouse_down;
+
+    for (int i = 0; i < 2; i++) {
+        const LaserPointerState& prev_laser = last.lasers[i];
+        const LaserPointerState& laser = in.lasers[i];
+        // Cursor overlays move on their own; the HUD only needs the pointer
+        if (!g_cursor_overlays.load(std::memory_order_relaxed) &&
+            (prev_laser.active != laser.active ||
+             (laser.active && (prev_laser.x != laser.x || prev_laser.y != laser.y)))) {
+            mark_dirty(g_hud_retained);
+        }
+        g_laser_states[i] = laser;
+    }
+
+    if (in.has_settings && (!last.has_settings ||
+        memcmp(&in.settings, &last.settings, sizeof(OverlaySettingsFFI)) != 0)) {
+        g_overlay_settings = in.settings;
+        publish_alert_settings();
+        mark_dirty(g_hud_retained);
+        mark_dirty(g_dashboard_retained);
+    }
+
+    if (in.has_dashboard && (!last.has_dashboard ||
+        in.dashboard.show_settings != last.dashboard.show_settings ||
+        in.dashboard.current_tab != last.dashboard.current_tab)) {
+        g_dashboard_state = in.dashboard;
+        post_dashboard_state();
+        mark_dirty(g_dashboard_retained);
+    }
+
+    last = in;
+}
+
+// ─────────────────────────── Render Scheduling ──────────────────────────
+// Poses and input are sampled every frame, but each overlay only redraws at
+// its own target rate: active_hz while the user is interacting with it,
+// idle_hz otherwise. A rate of 0 means every frame.
+enum OverlayId {
+    OVERLAY_HUD = 0,
+    OVERLAY_DASHBOARD = 1,
+    OVERLAY_KEYBOARD = 2,
+    OVERLAY_COUNT
+};
+
+struct RenderSchedule {
+    float active_hz = 0.0f;
+    float idle_hz = 0.0f;
+    double next_due = 0.0;
+};
+
+static RenderSchedule g_schedules[OVERLAY_COUNT];
+static OverlayQuality g_quality[OVERLAY_COUNT];
+
+// Slack so a render due "just after" this vsync isn't pushed to the next one
+static const double SCHEDULE_TOLERANCE_S = 0.001;
+
+static double now_seconds() {
+    using namespace std::chrono;
+    return duration<double>(steady_clock::now().time_since_epoch()).count();
+}
+
+static bool schedule_due(RenderSchedule& sched, float hz) {
+    if (hz <= 0.0f) return true;
+
+    double now = now_seconds();
+    if (now + SCHEDULE_TOLERANCE_S < sched.next_due) return false;
+
+    // Advance from the previous slot to avoid drift, but never schedule a
+    // burst of catch-up renders after a stall
+    double interval = 1.0 / hz;
+    sched.next_due += interval;
+    if (sched.next_due < now) sched.next_due = now + interval;
+    return true;
+}
+
+static bool schedule_due(OverlayId id, bool active) {
+    RenderSchedule& sched = g_schedules[id];
+    return schedule_due(sched, active ? sched.active_hz : sched.idle_hz);
+}
+
+extern "C" void vr_overlay_set_target_rate(int overlay_id, float active_hz, float idle_hz) {
+    if (overlay_id < 0 || overlay_id >= OVERLAY_COUNT) return;
+    g_schedules[overlay_id].active_hz = active_hz;
+    g_schedules[overlay_id].idle_hz = idle_hz;
+    g_schedules[overlay_id].next_due = 0.0;
+}
+
+// Supersample factor (1-4) and mip chain for an overlay. Like the target
+// rates, set these before vr_render_thread_start.
+extern "C" void vr_overlay_set_quality(int overlay_id, float supersample, bool mipmaps) {
+    if (overlay_id < 0 || overlay_id >= OVERLAY_COUNT) return;
+    g_quality[overlay_id].supersample = supersample;
+    g_quality[overlay_id].mipmaps = mipmaps;
+    if (overlay_id == OVERLAY_HUD) mark_dirty(g_hud_retained);
+    if (overlay_id == OVERLAY_DASHBOARD) mark_dirty(g_dashboard_retained);
+    if (overlay_id == OVERLAY_KEYBOARD) mark_dirty(g_keyboard_retained);
+}
+
+// ─────────────────────────── Frame Stats ───────────────────────────────
+// Each stage of the frame records its duration into a ring of recent
+// samples, and vr_get_frame_stats() reports percentiles over them. The UI,
+// draw and submit stages are sampled once per overlay render. GPU time
+// comes from timer queries read back frames later, never stalling on the
+// GPU. Samples arrive from both the input side and the render thread, so
+// recording takes a lock.
+enum FrameStage {
+    STAGE_FRAME = 0,        // Wake to wake of the frame loop
+    STAGE_WAIT = 1,         // Sleeping for the next frame
+    STAGE_CONTROLLERS = 2,  // vr_update_controllers
+    STAGE_UI = 3,           // Building the UI (NewFrame to Render)
+    STAGE_DRAW = 4,         // Clear, RenderDrawData and mip resolve, CPU side
+    STAGE_SUBMIT = 5,       // SetOverlayTexture
+    STAGE_GPU = 6,          // GPU time of the draw stage
+    STAGE_COUNT
+};
+
+static const int FRAME_STATS_HISTORY = 256;   // Samples kept per stage
+
+struct StageHistory {
+    float samples_ms[FRAME_STATS_HISTORY];
+    uint32_t count = 0;
+    uint32_t next = 0;
+    float last_ms = 0.0f;
+};
+
+struct FrameStageStats {
+    float last_ms;
+    float p50_ms;
+    float p99_ms;
+    float max_ms;
+    uint32_t samples;
+};
+
+struct FrameStats {
+    FrameStageStats stages[STAGE_COUNT];
+    uint32_t ui_allocations;        // ImGui allocations of the last UI build
+    uint32_t ui_heap_allocations;   // Of those, the ones the ImGui heap passed to malloc
+    uint64_t heap_allocations;      // ImGui heap mallocs since start
+};
+
+static std::mutex g_frame_stats_mutex;
+static StageHistory g_stage_history[STAGE_COUNT];
+
+// Allocations are counted over the same span as STAGE_UI
+struct AllocationMark {
+    uint64_t allocations;
+    uint64_t heap_allocations;
+};
+
+static std::atomic<uint32_t> g_ui_allocations{0};
+static std::atomic<uint32_t> g_ui_heap_allocations{0};
+
+static AllocationMark allocation_mark() {
+    return { g_imgui_allocations.load(std::memory_order_relaxed),
+             g_imgui_heap_allocations.load(std::memory_order_relaxed) };
+}
+
+static void record_allocations(const AllocationMark& since) {
+    AllocationMark now = allocation_mark();
+    g_ui_allocations.store((uint32_t)(now.allocations - since.allocations), std::memory_order_relaxed);
+    g_ui_heap_allocations.store((uint32_t)(now.heap_allocations - since.heap_allocations),
+                                std::memory_order_relaxed);
+}
+
+static void record_stage_ms(FrameStage stage, double ms) {
+    std::lock_guard<std::mutex> lock(g_frame_stats_mutex);
+    StageHistory& h = g_stage_history[stage];
+    h.samples_ms[h.next] = (float)ms;
+    h.next = (h.next + 1) % FRAME_STATS_HISTORY;
+    if (h.count < FRAME_STATS_HISTORY) h.count++;
+    h.last_ms = (float)ms;
+}
+
+static void record_stage(FrameStage stage, double start) {
+    record_stage_ms(stage, (now_seconds() - start) * 1000.0);
+}
+
+// Timer queries in flight. A slot whose result hasn't come back when its
+// turn comes round again is skipped rather than waited on.
+static bool g_gpu_timer_pending[GPU_TIMER_SLOTS] = {};
+static int g_gpu_timer_next = 0;
+
+static void collect_gpu_timers() {
+    for (int slot = 0; slot < GPU_TIMER_SLOTS; slot++) {
+        if (!g_gpu_timer_pending[slot]) continue;
+        double ms = 0.0;
+        if (!backend_timer_result(slot, &ms)) continue;
+        g_gpu_timer_pending[slot] = false;
+        if (ms >= 0.0) record_stage_ms(STAGE_GPU, ms);
+    }
+}
+
+// Start timing GPU work; -1 when no slot is free
+static int gpu_timer_begin() {
+    collect_gpu_timers();
+    int slot = g_gpu_timer_next;
+    if (g_gpu_timer_pending[slot] || !backend_timer_begin(slot)) return -1;
+    return slot;
+}
+
+static void gpu_timer_end(int slot) {
+    if (slot < 0) return;
+    backend_timer_end(slot);
+    g_gpu_timer_pending[slot] = true;
+    g_gpu_timer_next = (slot + 1) % GPU_TIMER_SLOTS;
+}
+
+static void destroy_gpu_timers() {
+    backend_timer_destroy_all();
+    for (bool& pending : g_gpu_timer_pending) pending = false;
+    g_gpu_timer_next = 0;
+}
+
+// Nearest-rank percentile of sorted samples
+static float sorted_percentile(const float* sorted, uint32_t count, float p) {
+    if (count == 0) return 0.0f;
+    uint32_t rank = (uint32_t)ceilf(p * (float)count);
+    return sorted[rank > 0 ? rank - 1 : 0];
+}
+
+extern "C" bool vr_get_frame_stats(FrameStats* out) {
+    if (!out) return false;
+    float samples[FRAME_STATS_HISTORY];
+    for (int i = 0; i < STAGE_COUNT; i++) {
+        uint32_t count;
+        float last;
+        {
+            std::lock_guard<std::mutex> lock(g_frame_stats_mutex);
+            const StageHistory& h = g_stage_history[i];
+            count = h.count;
+            last = h.last_ms;
+            memcpy(samples, h.samples_ms, count * sizeof(float));
+        }
+        std::sort(samples, samples + count);
+
+        FrameStageStats& st = out->stages[i];
+        st.last_ms = last;
+        st.p50_ms = sorted_percentile(samples, count, 0.50f);
+        st.p99_ms = sorted_percentile(samples, count, 0.99f);
+        st.max_ms = count ? samples[count - 1] : 0.0f;
+        st.samples = count;
+    }
+    out->ui_allocations = g_ui_allocations.load(std::memory_order_relaxed);
+    out->ui_heap_allocations = g_ui_heap_allocations.load(std::memory_order_relaxed);
+    out->heap_allocations = g_imgui_heap_allocations.load(std::memory_order_relaxed);
+    return true;
+}
+
+// ─────────────────────────── Overlay Placement Cache ───────────────────
+// Visibility, width and transform of the overlays we place ourselves are
+// mirrored here as they are set, so laser tests can reject overlays on the
+// CPU before asking the compositor for an exact intersection. Overlays
+// without a cached transform (e.g. the dashboard) are never rejected.
+struct OverlayPlacement {
+    VROverlayHandle_t handle = k_ulOverlayHandleInvalid;
+    bool visible = false;
+    float width_m = 0.0f;       // 0 when unknown
+    float aspect = 1.0f;        // Texture height / width, bounds the Y extent
+    bool has_transform = false;
+    TrackedDeviceIndex_t device = k_unTrackedDeviceIndexInvalid;  // Invalid = absolute
+    HmdMatrix34_t transform;
+};
+
+static const int MAX_OVERLAY_PLACEMENTS = 32;   // Fixed overlays, laser cursors and the registry
+static OverlayPlacement g_placements[MAX_OVERLAY_PLACEMENTS];
+
+static OverlayPlacement* find_placement(VROverlayHandle_t handle, bool create) {
+    if (handle == k_ulOverlayHandleInvalid) return nullptr;
+    OverlayPlacement* empty = nullptr;
+    for (int i = 0; i < MAX_OVERLAY_PLACEMENTS; i++) {
+        if (g_placements[i].handle == handle) return &g_placements[i];
+        if (!empty && g_placements[i].handle == k_ulOverlayHandleInvalid) empty = &g_placements[i];
+    }
+    if (!create || !empty) return nullptr;
+    *empty = OverlayPlacement();
+    empty->handle = handle;
+    return empty;
+}
+
+static void cache_overlay_visible(VROverlayHandle_t handle, bool visible) {
+    if (OverlayPlacement* p = find_placement(handle, true)) p->visible = visible;
+}
+
+static void cache_overlay_width(VROverlayHandle_t handle, float width_m) {
+    if (OverlayPlacement* p = find_placement(handle, true)) p->width_m = width_m;
+}
+
+static void cache_overlay_aspect(VROverlayHandle_t handle, float aspect) {
+    if (OverlayPlacement* p = find_placement(handle, true)) p->aspect = aspect;
+}
+
+static void forget_overlay(VROverlayHandle_t handle) {
+    if (OverlayPlacement* p = find_placement(handle, false)) *p = OverlayPlacement();
+}
+
+static void cache_overlay_transform(VROverlayHandle_t handle, TrackedDeviceIndex_t device,
+                                    const HmdMatrix34_t& transform) {
+    if (OverlayPlacement* p = find_placement(handle, true)) {
+        p->has_transform = true;
+        p->device = device;
+        p->transform = transform;
+    }
+}
+
+// The compositor re-evaluates device-relative transforms against the
+// device's pose every frame, so an overlay attached to the HMD or a tracker
+// only needs a new transform when its offset changes. Callers may set it
+// every frame: offsets within TRANSFORM_EPSILON of the one last submitted
+// are dropped here instead of costing an IPC call.
+static const float TRANSFORM_EPSILON = 1e-4f;   // Metres, or rotation units
+
+static bool transforms_close(const HmdMatrix34_t& a, const HmdMatrix34_t& b) {
+    for (int r = 0; r < 3; r++) {
+        for (int c = 0; c < 4; c++) {
+            if (fabsf(a.m[r][c] - b.m[r][c]) > TRANSFORM_EPSILON) return false;
+        }
+    }
+    return true;
+}
+
+static void set_device_relative_transform(VROverlayHandle_t handle, TrackedDeviceIndex_t device,
+                                          const HmdMatrix34_t& transform) {
+    const OverlayPlacement* p = find_placement(handle, false);
+    if (p && p->has_transform && p->device == device && transforms_close(p->transform, transform)) {
+        return;
+    }
+    VROverlay()->SetOverlayTransformTrackedDeviceRelative(handle, device, &transform);
+    cache_overlay_transform(handle, device, transform);
+}
+
+static HmdMatrix34_t mat34_mul(const HmdMatrix34_t& a, const HmdMatrix34_t& b) {
+    HmdMatrix34_t r;
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 4; j++) {
+            r.m[i][j] = a.m[i][0] * b.m[0][j] + a.m[i][1] * b.m[1][j] + a.m[i][2] * b.m[2][j] +
+                        (j == 3 ? a.m[i][3] : 0.0f);
+        }
+    }
+    return r;
+}
+
+static bool placement_world_transform(const OverlayPlacement& p, HmdMatrix34_t& out) {
+    if (!p.has_transform) return false;
+    if (p.device == k_unTrackedDeviceIndexInvalid) {
+        out = p.transform;
+        return true;
+    }
+    if (p.device >= k_unMaxTrackedDeviceCount) return false;
+    const TrackedDevicePose_t& pose = g_device_poses[p.device];
+    if (!pose.bPoseIsValid) return false;
+    out = mat34_mul(pose.mDeviceToAbsoluteTracking, p.transform);
+    return true;
+}
+
+// The HUD target follows the chat window size, so the render side publishes
+// the size it renders at and the input side (vr_update_controllers) resizes
+// the overlay to match, keeping the same physical size per pixel.
+static const float HUD_DEFAULT_METERS_PER_PIXEL = 1.0f / 1024.0f;  // 1 m at 1024 px
+
+static std::atomic<uint32_t> g_hud_target_width{0};
+static std::atomic<uint32_t> g_hud_target_height{0};
+static std::atomic<uint32_t> g_hud_target_serial{0};
+static uint32_t g_hud_target_synced = 0;               // Input side only
+static float g_hud_meters_per_pixel = HUD_DEFAULT_METERS_PER_PIXEL;  // Input side only
+
+static void publish_hud_target_size(uint32_t width, uint32_t height) {
+    if (g_hud_target_width.load(std::memory_order_relaxed) == width &&
+        g_hud_target_height.load(std::memory_order_relaxed) == height) {
+        return;
+    }
+    g_hud_target_width.store(width, std::memory_order_relaxed);
+    g_hud_target_height.store(height, std::memory_order_relaxed);
+    g_hud_target_serial.fetch_add(1, std::memory_order_release);
+}
+
+static void sync_hud_overlay_size() {
+    uint32_t serial = g_hud_target_serial.load(std::memory_order_acquire);
+    if (serial == g_hud_target_synced || g_handle == k_ulOverlayHandleInvalid) return;
+    g_hud_target_synced = serial;
+
+    uint32_t width = g_hud_target_width.load(std::memory_order_relaxed);
+    uint32_t height = g_hud_target_height.load(std::memory_order_relaxed);
+    if (width == 0 || height == 0) return;
+
+    float width_m = g_hud_meters_per_pixel * (float)width;
+    g_vro->SetOverlayWidthInMeters(g_handle, width_m);
+    cache_overlay_width(g_handle, width_m);
+    cache_overlay_aspect(g_handle, (float)height / (float)width);
+}
+
+// Size of the HUD texture last rendered, for mapping laser UVs to pixels
+extern "C" bool vr_get_hud_target_size(uint32_t* width, uint32_t* height) {
+    uint32_t w = g_hud_target_width.load(std::memory_order_relaxed);
+    uint32_t h = g_hud_target_height.load(std::memory_order_relaxed);
+    if (w == 0 || h == 0 || !width || !height) return false;
+    *width = w;
+    *height = h;
+    return true;
+}
+
+// ─────────────────────────── Overlay Registry ──────────────────────────
+// Besides the HUD, dashboard and keyboard, features (alerts, redeem popups,
+// OSC status, ...) register overlays of their own at runtime. Each entry
+// owns its overlay, swapchain, draw list and update rate, and shows a text
+// panel drawn like the keyboard: straight into its draw list, without an
+// ImGui frame. A render pass only draws entries that are visible, in view
+// of the HMD and changed since their last submit, at most at their rate;
+// anything else costs a few flag checks while the compositor keeps showing
+// its last texture. vr_registry_* calls come from the input side (the
+// thread calling vr_update_controllers), vr_registry_render from whichever
+// thread renders.
+static const int MAX_REGISTERED_OVERLAYS = 16;
+static const size_t REGISTRY_TITLE_MAX = 128;
+static const size_t REGISTRY_BODY_MAX = 1024;
+static const float REGISTRY_UI_SCALE = 2.0f;
+// Half-angle of the cone around the HMD's forward axis an overlay has to
+// touch to be drawn; wider than any headset's FOV so overlays just outside
+// it are up to date when the head turns
+static const float REGISTRY_VIEW_HALF_ANGLE = 1.2f;   // Radians, ~70 degrees
+
+enum RegistrySlot {
+    REGISTRY_FREE,
+    REGISTRY_OPEN,
+    REGISTRY_CLOSING,   // Destroyed; the render side still holds its targets
+};
+
+struct RegisteredOverlay {
+    std::atomic<int> slot{REGISTRY_FREE};
+    std::atomic<bool> visible{false};     // Input side
+    std::atomic<bool> in_view{true};      // Input side, see update_registry_view
+    RetainedState retained;
+    std::atomic<uint64_t> submitted_generation{0};   // Render side, last one on the overlay
+
+    // Written under g_registry_mutex by the input side
+    VROverlayHandle_t handle = k_ulOverlayHandleInvalid;
+    uint32_t width = 0;                   // Logical panel size
+    uint32_t height = 0;
+    float rate_hz = 0.0f;                 // 0 = whenever it changes
+    char title[REGISTRY_TITLE_MAX] = {};
+    char body[REGISTRY_BODY_MAX] = {};
+
+    // Render side only
+    OverlaySwapchain swapchain;
+    RenderSchedule schedule;
+    ImDrawList* draw_list = nullptr;
+};
+
+static RegisteredOverlay g_registry[MAX_REGISTERED_OVERLAYS];
+static std::atomic<int> g_registry_used{0};   // Slots below this were ever opened
+static std::mutex g_registry_mutex;
+
+static RegisteredOverlay* registry_entry(int32_t id) {
+    if (id < 0 || id >= MAX_REGISTERED_OVERLAYS) return nullptr;
+    RegisteredOverlay& e = g_registry[id];
+    return e.slot.load(std::memory_order_acquire) == REGISTRY_OPEN ? &e : nullptr;
+}
+
+// Create a hidden overlay of `width` x `height` logical pixels shown
+// `width_m` wide; -1 when the registry is full or OpenVR refuses it
+extern "C" int32_t vr_registry_create(const char* key, const char* name,
+                                      uint32_t width, uint32_t height, float width_m) {
+    if (!key || !name || width == 0 || height == 0 ||
+        width > MAX_RENDER_TARGET_SIZE || height > MAX_RENDER_TARGET_SIZE) {
+        return -1;
+    }
+    int id = 0;
+    while (id < MAX_REGISTERED_OVERLAYS && g_registry[id].slot.load(std::memory_order_acquire) != REGISTRY_FREE) {
+        id++;
+    }
+    if (id == MAX_REGISTERED_OVERLAYS) return -1;
+
+    VROverlayHandle_t handle = k_ulOverlayHandleInvalid;
+    if (VROverlay()->CreateOverlay(key, name, &handle) != VROverlayError_None) return -1;
+    VROverlay()->SetOverlayWidthInMeters(handle, width_m);
+    cache_overlay_width(handle, width_m);
+    cache_overlay_aspect(handle, (float)height / (float)width);
+    cache_overlay_visible(handle, false);
+
+    RegisteredOverlay& e = g_registry[id];
+    {
+        std::lock_guard<std::mutex> lock(g_registry_mutex);
+        e.handle = handle;
+        e.width = width;
+        e.height = height;
+        e.rate_hz = 0.0f;
+        e.title[0] = 0;
+        e.body[0] = 0;
+    }
+    e.visible.store(false, std::memory_order_relaxed);
+    e.in_view.store(true, std::memory_order_relaxed);
+    mark_dirty(e.retained);
+    e.slot.store(REGISTRY_OPEN, std::memory_order_release);
+    if (g_registry_used.load(std::memory_order_relaxed) <= id) {
+        g_registry_used.store(id + 1, std::memory_order_release);
+    }
+    return id;
+}
+
+// The slot is reusable once the render side has released its targets
+extern "C" void vr_registry_destroy(int32_t id) {
+    RegisteredOverlay* e = registry_entry(id);
+    if (!e) return;
+    VROverlayHandle_t handle;
+    {
+        std::lock_guard<std::mutex> lock(g_registry_mutex);
+        handle = e->handle;
+        e->handle = k_ulOverlayHandleInvalid;
+    }
+    e->visible.store(false, std::memory_order_relaxed);
+    e->slot.store(REGISTRY_CLOSING, std::memory_order_release);
+    VROverlay()->DestroyOverlay(handle);
+    forget_overlay(handle);
+}
+
+extern "C" VROverlayHandle_t vr_registry_handle(int32_t id) {
+    RegisteredOverlay* e = registry_entry(id);
+    return e ? e->handle : k_ulOverlayHandleInvalid;
+}
+
+// Whether the entry's current content has reached its overlay
+static bool registry_submitted(int32_t id) {
+    RegisteredOverlay* e = registry_entry(id);
+    return e && e->submitted_generation.load(std::memory_order_acquire) ==
+                e->retained.generation.load(std::memory_order_acquire);
+}
+
+extern "C" void vr_registry_set_visible(int32_t id, bool visible) {
+    RegisteredOverlay* e = registry_entry(id);
+    if (!e || e->visible.load(std::memory_order_relaxed) == visible) return;
+    if (visible) {
+        VROverlay()->ShowOverlay(e->handle);
+    } else {
+        VROverlay()->HideOverlay(e->handle);
+    }
+    cache_overlay_visible(e->handle, visible);
+    e->visible.store(visible, std::memory_order_relaxed);
+}
+
+// Upper bound on how often the panel redraws while its content changes
+extern "C" void vr_registry_set_rate(int32_t id, float hz) {
+    RegisteredOverlay* e = registry_entry(id);
+    if (!e) return;
+    std::lock_guard<std::mutex> lock(g_registry_mutex);
+    e->rate_hz = hz;
+}
+
+extern "C" void vr_registry_set_text(int32_t id, const char* title, const char* body) {
+    RegisteredOverlay* e = registry_entry(id);
+    if (!e) return;
+    const char* t = title ? title : "";
+    const char* b = body ? body : "";
+    {
+        std::lock_guard<std::mutex> lock(g_registry_mutex);
+        if (strncmp(e->title, t, REGISTRY_TITLE_MAX - 1) == 0 &&
+            strncmp(e->body, b, REGISTRY_BODY_MAX - 1) == 0) {
+            return;
+        }
+        snprintf(e->title, sizeof(e->title), "%s", t);
+        snprintf(e->body, sizeof(e->body), "%s", b);
+    }
+    mark_dirty(e->retained);
+}
+
+// Whether the overlay's bounding sphere touches the HMD's view cone.
+// Overlays without a known placement, or while the HMD pose is invalid,
+// count as seen.
+static bool placement_in_view(const OverlayPlacement& p) {
+    const TrackedDevicePose_t& hmd = g_device_poses[k_unTrackedDeviceIndex_Hmd];
+    HmdMatrix34_t w;
+    if (!hmd.bPoseIsValid || !placement_world_transform(p, w)) return true;
+    const HmdMatrix34_t& h = hmd.mDeviceToAbsoluteTracking;
+
+    float dx = w.m[0][3] - h.m[0][3], dy = w.m[1][3] - h.m[1][3], dz = w.m[2][3] - h.m[2][3];
+    float dist = sqrtf(dx * dx + dy * dy + dz * dz);
+    float radius = 0.5f * p.width_m * sqrtf(1.0f + p.aspect * p.aspect);
+    if (dist <= radius) return true;
+
+    // The HMD looks down its -Z axis
+    float cos_angle = -(dx * h.m[0][2] + dy * h.m[1][2] + dz * h.m[2][2]) / dist;
+    float angle = acosf(fmaxf(-1.0f, fminf(1.0f, cos_angle)));
+    return angle <= REGISTRY_VIEW_HALF_ANGLE + asinf(radius / dist);
+}
+
+// Input side, once the frame's poses are in
+static void update_registry_view() {
+    int used = g_registry_used.load(std::memory_order_acquire);
+    for (int i = 0; i < used; i++) {
+        RegisteredOverlay& e = g_registry[i];
+        if (e.slot.load(std::memory_order_acquire) != REGISTRY_OPEN ||
+            !e.visible.load(std::memory_order_relaxed)) {
+            continue;
+        }
+        const OverlayPlacement* p = find_placement(e.handle, false);
+        e.in_view.store(!p || placement_in_view(*p), std::memory_order_relaxed);
+    }
+}
+
+static void build_registry_draw_list(ImDrawList* dl, float width, float height,
+                                     const char* title, const char* body) {
+    ImFont* font = ImGui::GetFont();
+    const float font_size = font->FontSize * REGISTRY_UI_SCALE;
+    const float padding = 8.0f * REGISTRY_UI_SCALE;
+
+    dl->_ResetForNewFrame();
+    dl->PushClipRect(ImVec2(0, 0), ImVec2(width, height));
+    dl->PushTextureID(ImGui::GetIO().Fonts->TexID);
+
+    dl->AddRectFilled(ImVec2(0, 0), ImVec2(width, height), ImGui::GetColorU32(ImGuiCol_WindowBg),
+                      ImGui::GetStyle().WindowRounding * REGISTRY_UI_SCALE);
+    float y = padding;
+    if (title[0]) {
+        dl->AddText(font, font_size, ImVec2(padding, y), ImGui::GetColorU32(ImGuiCol_CheckMark), title);
+        y += font_size + padding * 0.5f;
+    }
+    dl->AddText(font, font_size, ImVec2(padding, y), ImGui::GetColorU32(ImGuiCol_Text),
+                body, nullptr, width - 2.0f * padding);
+
+    dl->PopTextureID();
+    dl->PopClipRect();
+}
+
+static void close_registry_entry(RegisteredOverlay& e) {
+    swapchain_release(e.swapchain);
+    if (e.draw_list) {
+        IM_DELETE(e.draw_list);
+        e.draw_list = nullptr;
+    }
+    e.schedule = RenderSchedule();
+    e.retained.rendered_generation = 0;
+    e.submitted_generation.store(0, std::memory_order_relaxed);
+    e.slot.store(REGISTRY_FREE, std::memory_order_release);
+}
+
+static bool render_registry_entry(RegisteredOverlay& e, uint64_t generation) {
+    VROverlayHandle_t handle;
+    uint32_t width, height;
+    char title[REGISTRY_TITLE_MAX];
+    char body[REGISTRY_BODY_MAX];
+    {
+        std::lock_guard<std::mutex> lock(g_registry_mutex);
+        if (!schedule_due(e.schedule, e.rate_hz)) return true;
+        handle = e.handle;
+        width = e.width;
+        height = e.height;
+        memcpy(title, e.title, sizeof(title));
+        memcpy(body, e.body, sizeof(body));
+    }
+
+    if (!swapchain_acquire(e.swapchain, width, height, OverlayQuality())) return false;
+    RenderTarget* target = swapchain_target(e.swapchain);
+    if (!target) return true;   // GPU still busy; the generation stays unrendered
+    e.retained.rendered_generation = generation;
+    if (!e.draw_list) e.draw_list = IM_NEW(ImDrawList)(ImGui::GetDrawListSharedData());
+
+    double ui_start = now_seconds();
+    AllocationMark ui_allocs = allocation_mark();
+    build_registry_draw_list(e.draw_list, (float)width, (float)height, title, body);
+    record_stage(STAGE_UI, ui_start);
+    record_allocations(ui_allocs);
+
+    double draw_start = now_seconds();
+    int gpu_timer = gpu_timer_begin();
+    backend_bind_target(target);
+    float clear_color[4] = { 0.0f, 0.0f, 0.0f, 0.0f };
+    backend_clear_target(target, clear_color, nullptr);
+
+    static ImDrawData draw_data;  // Reused; its list array would be allocated every render
+    draw_data.Clear();
+    draw_data.Valid = true;
+    draw_data.DisplayPos = ImVec2(0.0f, 0.0f);
+    draw_data.DisplaySize = ImVec2((float)width, (float)height);
+    draw_data.FramebufferScale = ImVec2(1.0f, 1.0f);
+    draw_data.AddDrawList(e.draw_list);
+    scale_draw_data(&draw_data, e.swapchain.scale);
+    backend_render_draw_data(&draw_data);
+    backend_resolve_target(target);
+    gpu_timer_end(gpu_timer);
+    record_stage(STAGE_DRAW, draw_start);
+
+    double submit_start = now_seconds();
+    VROverlayError err = backend_submit_target(handle, target);
+    record_stage(STAGE_SUBMIT, submit_start);
+
+    swapchain_advance(e.swapchain);
+    if (err != VROverlayError_None) return false;
+    e.submitted_generation.store(generation, std::memory_order_release);
+    return true;
+}
+
+// Draw every registered overlay that needs it; false if a submit failed
+extern "C" bool vr_registry_render() {
+    bool ok = true;
+    int used = g_registry_used.load(std::memory_order_acquire);
+    for (int i = 0; i < used; i++) {
+        RegisteredOverlay& e = g_registry[i];
+        int slot = e.slot.load(std::memory_order_acquire);
+        if (slot == REGISTRY_CLOSING) {
+            close_registry_entry(e);
+            continue;
+        }
+        if (slot != REGISTRY_OPEN || !g_imgui_frame_ready) continue;
+        if (!e.visible.load(std::memory_order_relaxed) || !e.in_view.load(std::memory_order_relaxed)) {
+            continue;
+        }
+        uint64_t generation = e.retained.generation.load(std::memory_order_acquire);
+        if (g_retained_mode && generation == e.retained.rendered_generation) continue;
+        if (!render_registry_entry(e, generation)) ok = false;
+    }
+    return ok;
+}
+
+// Render side of imgui_shutdown: targets and draw lists go, entries stay
+static void release_registry_render_state() {
+    for (RegisteredOverlay& e : g_registry) {
+        swapchain_release(e.swapchain);
+        if (e.draw_list) {
+            IM_DELETE(e.draw_list);
+            e.draw_list = nullptr;
+        }
+        e.retained.rendered_generation = 0;
+    }
+}
+
+static void destroy_registered_overlays() {
+    for (int i = 0; i < MAX_REGISTERED_OVERLAYS; i++) vr_registry_destroy(i);
+}
+
+// ─────────────────────────── Alerts ────────────────────────────────────
+// Follow, sub and redeem alerts take turns in two registered overlays near
+// the top of the view. Each alert is rasterized once, while its overlay is
+// shown at zero alpha, and is then faded and slid in and out through
+// SetOverlayAlpha and its HMD-relative transform alone: an alert on screen
+// costs no redraws. While one overlay shows an alert the next queued one is
+// rasterized into the other, so a raid's burst costs one panel draw per
+// alert, spread over the display time of the one before it. Alerts are
+// posted and animated on the input side.
+enum AlertKind {
+    ALERT_FOLLOW = 0,
+    ALERT_SUB = 1,
+    ALERT_REDEEM = 2,
+    ALERT_KIND_COUNT
+};
+
+static const char* const ALERT_DEFAULT_TITLES[ALERT_KIND_COUNT] = {
+    "New Follower", "New Subscriber", "Channel Points Redeem"
+};
+
+static const uint32_t ALERT_WIDTH = 640;
+static const uint32_t ALERT_HEIGHT = 160;
+static const float ALERT_WIDTH_M = 0.5f;
+static const float ALERT_DISTANCE_M = 1.2f;     // In front of the HMD
+static const float ALERT_RAISE_M = 0.25f;       // Above the view centre at rest
+static const float ALERT_SLIDE_M = 0.08f;       // Further up while faded out
+static const double ALERT_FADE_S = 0.3;
+static const size_t ALERT_QUEUE_MAX = 32;       // Beyond this the oldest pending alert is dropped
+static const int ALERT_SLOTS = 2;
+
+enum AlertPhase {
+    ALERT_IDLE,
+    ALERT_PREPARING,    // Shown at zero alpha until its panel is submitted
+    ALERT_SHOWING,
+};
+
+struct AlertSlot {
+    int32_t id = -1;            // Registry entry
+    AlertPhase phase = ALERT_IDLE;
+    uint64_t order = 0;         // Queue order of the alert it holds
+    double shown_at = 0.0;
+    float alpha = -1.0f;        // Last sent to the compositor
+};
+
+struct PendingAlert {
+    std::string title;
+    std::string body;
+};
+
+// Input side
+static AlertSlot g_alert_slots[ALERT_SLOTS];
+static int g_alert_showing = -1;
+static uint64_t g_alert_order = 0;
+static std::deque<PendingAlert> g_alert_queue;
+
+// Fades only cost an IPC call per visible step
+static void set_alert_alpha(AlertSlot& s, float alpha) {
+    if (alpha == s.alpha) return;
+    if (fabsf(alpha - s.alpha) < 1.0f / 255.0f && alpha > 0.0f && alpha < 1.0f) return;
+    VROverlay()->SetOverlayAlpha(vr_registry_handle(s.id), alpha);
+    s.alpha = alpha;
+}
+
+// `slide` runs from 0 at rest to 1 fully raised
+static void place_alert(const AlertSlot& s, float slide) {
+    HmdMatrix34_t m{};
+    m.m[0][0] = m.m[1][1] = m.m[2][2] = 1.0f;
+    m.m[1][3] = ALERT_RAISE_M + slide * ALERT_SLIDE_M;
+    m.m[2][3] = -ALERT_DISTANCE_M;
+    set_device_relative_transform(vr_registry_handle(s.id), k_unTrackedDeviceIndex_Hmd, m);
+}
+
+static bool create_alert_slots() {
+    for (int i = 0; i < ALERT_SLOTS; i++) {
+        AlertSlot& s = g_alert_slots[i];
+        if (s.id >= 0) continue;
+        char key[64];
+        snprintf(key, sizeof(key), "maowbot.overlay.alert.%d", i);
+        s.id = vr_registry_create(key, "maowbot Alert", ALERT_WIDTH, ALERT_HEIGHT, ALERT_WIDTH_M);
+        if (s.id < 0) return false;
+        s = AlertSlot{s.id};
+    }
+    return true;
+}
+
+static void prepare_alert(AlertSlot& s, const PendingAlert& alert) {
+    vr_registry_set_text(s.id, alert.title.c_str(), alert.body.c_str());
+    set_alert_alpha(s, 0.0f);
+    place_alert(s, 1.0f);
+    vr_registry_set_visible(s.id, true);
+    s.phase = ALERT_PREPARING;
+    s.order = ++g_alert_order;
+}
+
+static void retire_alert(AlertSlot& s) {
+    vr_registry_set_visible(s.id, false);
+    s.phase = ALERT_IDLE;
+}
+
+// Queue an alert; an empty title falls back to the kind's
+extern "C" void vr_alert_post(int kind, const char* title, const char* body) {
+    if (kind < 0 || kind >= ALERT_KIND_COUNT) return;
+    if (!g_alerts_enabled.load(std::memory_order_relaxed) || !create_alert_slots()) return;
+    if (g_alert_queue.size() >= ALERT_QUEUE_MAX) g_alert_queue.pop_front();
+    PendingAlert alert;
+    alert.title = title && title[0] ? title : ALERT_DEFAULT_TITLES[kind];
+    alert.body = body ? body : "";
+    g_alert_queue.push_back(std::move(alert));
+}
+
+static void update_alerts() {
+    if (g_alert_slots[0].id < 0) return;   // Nothing posted yet
+    if (!g_alerts_enabled.load(std::memory_order_relaxed)) {
+        g_alert_queue.clear();
+        for (AlertSlot& s : g_alert_slots) {
+            if (s.phase != ALERT_IDLE) retire_alert(s);
+        }
+        g_alert_showing = -1;
+        return;
+    }
+
+    double now = now_seconds();
+    double duration = fmax((double)g_alert_duration.load(std::memory_order_relaxed), 2.0 * ALERT_FADE_S);
+    if (g_alert_showing >= 0) {
+        AlertSlot& s = g_alert_slots[g_alert_showing];
+        double t = now - s.shown_at;
+        if (t >= duration) {
+            retire_alert(s);
+            g_alert_showing = -1;
+        } else {
+            // Smoothstep in over the first ALERT_FADE_S and out over the last
+            float k = (float)fmin(fmin(t, duration - t) / ALERT_FADE_S, 1.0);
+            k = k * k * (3.0f - 2.0f * k);
+            set_alert_alpha(s, k);
+            place_alert(s, 1.0f - k);
+        }
+    }
+
+    for (AlertSlot& s : g_alert_slots) {
+        if (s.phase != ALERT_IDLE || g_alert_queue.empty()) continue;
+        prepare_alert(s, g_alert_queue.front());
+        g_alert_queue.pop_front();
+    }
+
+    if (g_alert_showing >= 0) return;
+    int next = -1;
+    for (int i = 0; i < ALERT_SLOTS; i++) {
+        const AlertSlot& s = g_alert_slots[i];
+        if (s.phase == ALERT_PREPARING && (next < 0 || s.order < g_alert_slots[next].order)) next = i;
+    }
+    // Alerts keep their order: the oldest waits for its panel even if a newer one is ready
+    if (next < 0 || !registry_submitted(g_alert_slots[next].id)) return;
+    g_alert_slots[next].phase = ALERT_SHOWING;
+    g_alert_slots[next].shown_at = now;
+    g_alert_showing = next;
+}
+
+// ─────────────────────────── Laser Cursors ─────────────────────────────
+// Each controller's laser dot is its own small overlay placed relative to
+// the HUD, so pointing around only moves a transform and leaves the chat
+// texture alone. The dot images are built once on the CPU and uploaded with
+// SetOverlayRaw. With cursor overlays off the HUD draws the dots itself.
+static const uint32_t CURSOR_TEXTURE_SIZE = 64;
+static const float CURSOR_HUD_PIXELS = 48.0f;    // Cursor width in HUD pixels
+static const float CURSOR_LIFT_M = 0.001f;       // In front of the HUD plane
+static const uint8_t CURSOR_COLORS[2][3] = {{100, 200, 255}, {255, 200, 100}};
+
+struct LaserCursor {
+    VROverlayHandle_t handle = k_ulOverlayHandleInvalid;
+    bool visible = false;
+    float x = 0.0f, y = 0.0f;
+    uint32_t hud_width = 0, hud_height = 0;
+    float width_m = 0.0f;
+};
+
+static LaserCursor g_cursors[2];                 // Input side only
+
+// Blend a ring (inner radius > 0) or disc into a straight-alpha RGBA image,
+// antialiased over one pixel
+static void cursor_blend(uint8_t* px, float dist, float inner, float outer,
+                         const uint8_t rgb[3], float alpha) {
+    float cover = fminf(fmaxf(outer - dist + 0.5f, 0.0f), 1.0f);
+    if (inner > 0.0f) cover *= fminf(fmaxf(dist - inner + 0.5f, 0.0f), 1.0f);
+    float a = cover * alpha;
+    if (a <= 0.0f) return;
+
+    float dst_a = px[3] / 255.0f;
+    float out_a = a + dst_a * (1.0f - a);
+    for (int c = 0; c < 3; c++) {
+        float blended = (rgb[c] * a + px[c] * dst_a * (1.0f - a)) / out_a;
+        px[c] = (uint8_t)(blended + 0.5f);
+    }
+    px[3] = (uint8_t)(out_a * 255.0f + 0.5f);
+}
+
+// Same rings as render_laser_pointers, in HUD pixels
+static void build_cursor_image(std::vector<uint8_t>& rgba, const uint8_t color[3]) {
+    static const uint8_t white[3] = {255, 255, 255};
+    const float texels_per_pixel = CURSOR_TEXTURE_SIZE / CURSOR_HUD_PIXELS;
+    rgba.assign(CURSOR_TEXTURE_SIZE * CURSOR_TEXTURE_SIZE * 4, 0);
+    for (uint32_t y = 0; y < CURSOR_TEXTURE_SIZE; y++) {
+        for (uint32_t x = 0; x < CURSOR_TEXTURE_SIZE; x++) {
+            float dx = (x + 0.5f) - CURSOR_TEXTURE_SIZE * 0.5f;
+            float dy = (y + 0.5f) - CURSOR_TEXTURE_SIZE * 0.5f;
+            float dist = sqrtf(dx * dx + dy * dy) / texels_per_pixel;
+            uint8_t* px = &rgba[(y * CURSOR_TEXTURE_SIZE + x) * 4];
+            cursor_blend(px, dist, 18.5f, 21.5f, white, 0.5f);   // Outer ring
+            cursor_blend(px, dist, 14.0f, 16.0f, color, 1.0f);   // Middle ring
+            cursor_blend(px, dist, 0.0f, 8.0f, color, 1.0f);     // Inner disc
+            cursor_blend(px, dist, 0.0f, 3.0f, white, 1.0f);     // Center dot
+        }
+    }
+}
+
+static void create_laser_cursors(uint32_t hud_sort_order) {
+    std::vector<uint8_t> rgba;
+    for (int i = 0; i < 2; i++) {
+        LaserCursor& c = g_cursors[i];
+        if (c.handle == k_ulOverlayHandleInvalid) {
+            char key[64], name[64];
+            snprintf(key, sizeof(key), "maowbot.overlay.cursor%d", i);
+            snprintf(name, sizeof(name), "maowbot Cursor %d", i);
+            if (VROverlay()->CreateOverlay(key, name, &c.handle) != VROverlayError_None) {
+                c.handle = k_ulOverlayHandleInvalid;
+                continue;
+            }
+            build_cursor_image(rgba, CURSOR_COLORS[i]);
+            VROverlay()->SetOverlayRaw(c.handle, rgba.data(), CURSOR_TEXTURE_SIZE, CURSOR_TEXTURE_SIZE, 4);
+        }
+        VROverlay()->SetOverlaySortOrder(c.handle, hud_sort_order + 1);
+    }
+}
+
+static void destroy_laser_cursors() {
+    for (int i = 0; i < 2; i++) {
+        if (g_cursors[i].handle != k_ulOverlayHandleInvalid) g_vro->DestroyOverlay(g_cursors[i].handle);
+        g_cursors[i] = LaserCursor();
+    }
+}
+
+static void hide_laser_cursor(LaserCursor& c) {
+    if (!c.visible) return;
+    VROverlay()->HideOverlay(c.handle);
+    c.visible = false;
+}
+
+// Place a cursor at HUD pixel (x, y). Only touches the compositor when the
+// position, HUD size or HUD scale changed.
+static void update_laser_cursor(int controller_idx, bool active, float x, float y) {
+    LaserCursor& c = g_cursors[controller_idx];
+    if (c.handle == k_ulOverlayHandleInvalid) return;
+
+    uint32_t hud_width = g_hud_target_width.load(std::memory_order_relaxed);
+    uint32_t hud_height = g_hud_target_height.load(std::memory_order_relaxed);
+    if (!active || !g_cursor_overlays.load(std::memory_order_relaxed) || hud_width == 0 || hud_height == 0) {
+        hide_laser_cursor(c);
+        return;
+    }
+
+    float width_m = CURSOR_HUD_PIXELS * g_hud_meters_per_pixel;
+    if (c.visible && c.x == x && c.y == y && c.hud_width == hud_width &&
+        c.hud_height == hud_height && c.width_m == width_m) {
+        return;
+    }
+    if (c.width_m != width_m) VROverlay()->SetOverlayWidthInMeters(c.handle, width_m);
+
+    HmdMatrix34_t m = {{{1.0f, 0.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 1.0f, 0.0f}}};
+    m.m[0][3] = (x - hud_width * 0.5f) * g_hud_meters_per_pixel;
+    m.m[1][3] = (hud_height * 0.5f - y) * g_hud_meters_per_pixel;
+    m.m[2][3] = CURSOR_LIFT_M;
+    VROverlay()->SetOverlayTransformOverlayRelative(c.handle, g_handle, &m);
+    if (!c.visible) VROverlay()->ShowOverlay(c.handle);
+
+    c.visible = true;
+    c.x = x;
+    c.y = y;
+    c.hud_width = hud_width;
+    c.hud_height = hud_height;
+    c.width_m = width_m;
+}
 
-struct LaserHit {
-    bool hit;
-    float u, v;
-    float distance;
-};
+// Draw laser dots as separate overlays (default) or into the HUD texture
+extern "C" void vr_set_laser_cursor_overlays(bool enabled) {
+    if (g_cursor_overlays.exchange(enabled) == enabled) return;
+    if (!enabled) {
+        for (int i = 0; i < 2; i++) {
+            if (g_cursors[i].handle != k_ulOverlayHandleInvalid) hide_laser_cursor(g_cursors[i]);
+        }
+    }
+    mark_dirty(g_hud_retained);
+}
 
 extern "C" void vr_show_overlay(VROverlayHandle_t handle) {
     if (handle != k_ulOverlayHandleInvalid) {
         VROverlay()->ShowOverlay(handle);
+        cache_overlay_visible(handle, true);
     }
 }
 
 extern "C" void vr_hide_overlay(VROverlayHandle_t handle) {
     if (handle != k_ulOverlayHandleInvalid) {
         VROverlay()->HideOverlay(handle);
+        cache_overlay_visible(handle, false);
     }
 }
 
@@ -158,6 +1859,8 @@ extern "C" void vr_shutdown() {
     if (g_handle) g_vro->DestroyOverlay(g_handle);
     if (g_dashboard_handle) g_vro->DestroyOverlay(g_dashboard_handle);
     if (g_keyboard_handle) g_vro->DestroyOverlay(g_keyboard_handle);
+    destroy_laser_cursors();
+    destroy_registered_overlays();
     VR_Shutdown();
 }
 
@@ -172,11 +1875,16 @@ extern "C" bool vr_create_overlays() {
     VROverlay()->SetOverlayWidthInMeters(g_handle, 1.0f);
     VROverlay()->SetOverlayInputMethod(g_handle, VROverlayInputMethod_Mouse);
     VROverlay()->ShowOverlay(g_handle);
+    cache_overlay_width(g_handle, 1.0f);
+    cache_overlay_visible(g_handle, true);
     
     // Enable interaction flags for HUD
     VROverlay()->SetOverlayFlag(g_handle, VROverlayFlags_SendVRDiscreteScrollEvents, true);
     VROverlay()->SetOverlayFlag(g_handle, VROverlayFlags_SendVRSmoothScrollEvents, true);
     VROverlay()->SetOverlayFlag(g_handle, VROverlayFlags_ShowTouchPadScrollWheel, false);
+
+    // Laser dots sit just above the HUD; failing to create them isn't fatal
+    create_laser_cursors(0);
     
     // Create Dashboard overlay (settings)
     VROverlayHandle_t thumb;
@@ -218,6 +1926,8 @@ extern "C" VROverlayHandle_t vr_create_overlay_raw(const char* key, const char*
         if (visible) {
             VROverlay()->ShowOverlay(handle);
         }
+        cache_overlay_width(handle, width_m);
+        cache_overlay_visible(handle, visible);
         return handle;
     }
 
@@ -227,29 +1937,24 @@ extern "C" VROverlayHandle_t vr_create_overlay_raw(const char* key, const char*
 extern "C" void vr_destroy_overlay(VROverlayHandle_t handle) {
     if (handle != k_ulOverlayHandleInvalid) {
         VROverlay()->DestroyOverlay(handle);
+        forget_overlay(handle);
     }
 }
 
-extern "C" bool vr_overlay_poll(VREvent_t* e) {
-    return g_vro->PollNextOverlayEvent(g_handle, e, sizeof(VREvent_t));
-}
-
-extern "C" bool vr_dashboard_poll(VREvent_t* e) {
-    return g_vro->PollNextOverlayEvent(g_dashboard_handle, e, sizeof(VREvent_t));
-}
-
 extern "C" void vr_center_in_front(float meters) {
     if (g_handle == k_ulOverlayHandleInvalid) return;
     HmdMatrix34_t m{};
     m.m[2][3] = -meters;
     m.m[0][0] = m.m[1][1] = m.m[2][2] = 1.0f;
-    VROverlay()->SetOverlayTransformTrackedDeviceRelative(
-        g_handle, k_unTrackedDeviceIndex_Hmd, &m);
+    set_device_relative_transform(g_handle, k_unTrackedDeviceIndex_Hmd, m);
 }
 
 extern "C" void vr_set_overlay_transform_tracked_device_relative(
     VROverlayHandle_t handle, uint32_t device_index, const HmdMatrix34_t* transform) {
-    if (handle != k_ulOverlayHandleInvalid) {
+    if (handle == k_ulOverlayHandleInvalid) return;
+    if (transform) {
+        set_device_relative_transform(handle, device_index, *transform);
+    } else {
         VROverlay()->SetOverlayTransformTrackedDeviceRelative(handle, device_index, transform);
     }
 }
@@ -261,11 +1966,18 @@ extern "C" void vr_show_dashboard(const char* key) {
 extern "C" void vr_set_sort_order(uint32_t order) {
     if (g_handle == k_ulOverlayHandleInvalid) return;
     VROverlay()->SetOverlaySortOrder(g_handle, order);
+    create_laser_cursors(order);
 }
 
 extern "C" void vr_set_overlay_width_meters(float meters) {
-    if (g_handle != k_ulOverlayHandleInvalid)
+    if (g_handle != k_ulOverlayHandleInvalid) {
         VROverlay()->SetOverlayWidthInMeters(g_handle, meters);
+        cache_overlay_width(g_handle, meters);
+
+        // Later HUD resizes keep this physical size per pixel
+        uint32_t width = g_hud_target_width.load(std::memory_order_relaxed);
+        g_hud_meters_per_pixel = meters / (float)(width ? width : 1024);
+    }
 }
 
 extern "C" void vr_compositor_sync() {
@@ -275,90 +1987,167 @@ extern "C" void vr_compositor_sync() {
     }
 }
 
-// Also add a proper frame timing function
-extern "C" void vr_wait_get_poses() {
-    if (auto* comp = VRCompositor()) {
-        TrackedDevicePose_t poses[k_unMaxTrackedDeviceCount];
-        comp->WaitGetPoses(poses, k_unMaxTrackedDeviceCount, nullptr, 0);
-    }
+// ─────────────────────────── Frame Pacing ──────────────────────────────
+// WaitGetPoses belongs to the scene application; an overlay calling it
+// competes with the game for the compositor's frame timing. vr_wait_frame()
+// reads the vsync phase from IVRSystem instead and returns once per display
+// frame, a lead time before the next vsync. The lead tracks how long the
+// caller's frame work takes, so input is sampled as late as possible while
+// the frame still lands before the compositor needs it. Sleeps stop short of
+// the target by how late the OS has been waking us and yield the rest.
+static const double PACING_DEFAULT_HZ = 90.0;
+static const double PACING_MIN_LEAD_S = 0.0005;
+static const double PACING_SPIN_S = 0.0005;      // Always yield, not sleep, this close to the target
+static const double PACING_EMA_WEIGHT = 0.1;     // Weight of the newest sample
+static const double PACING_HZ_REFRESH_S = 1.0;   // Display rate can change at runtime
+
+static double g_pacing_hz = PACING_DEFAULT_HZ;
+static double g_pacing_hz_read_time = -1.0;
+static uint64_t g_pacing_served_vsync = 0;  // Vsync counter we last woke for
+static bool g_pacing_has_served = false;
+static double g_pacing_work_s = 0.0;        // Time from our wake to the next vr_wait_frame
+static double g_pacing_sleep_slack_s = 0.0; // How late sleep_for returns
+static double g_pacing_wake_time = -1.0;
+
+// Frame and wait samples for the frame the loop is about to start
+static void record_pacing_wake(double entered) {
+    double wake = now_seconds();
+    if (g_pacing_wake_time >= 0.0) record_stage_ms(STAGE_FRAME, (wake - g_pacing_wake_time) * 1000.0);
+    record_stage_ms(STAGE_WAIT, (wake - entered) * 1000.0);
+    g_pacing_wake_time = wake;
 }
 
-// Add keyboard initialization
-extern "C" bool vr_keyboard_init_rendering(void* device_ptr, void* context_ptr) {
-    if (!device_ptr || !context_ptr) return false;
-
-    // Create keyboard textures (smaller size)
-    const int width = 512;
-    const int height = 384;
-
-    D3D11_TEXTURE2D_DESC desc = {};
-    desc.Width = width;
-    desc.Height = height;
-    desc.MipLevels = 1;
-    desc.ArraySize = 1;
-    desc.Format = DXGI_FORMAT_B8G8R8A8_UNORM;
-    desc.SampleDesc.Count = 1;
-    desc.Usage = D3D11_USAGE_DEFAULT;
-    desc.BindFlags = D3D11_BIND_RENDER_TARGET | D3D11_BIND_SHADER_RESOURCE;
-    desc.MiscFlags = D3D11_RESOURCE_MISC_SHARED;
+static double pacing_display_hz() {
+    double now = now_seconds();
+    if (g_pacing_hz_read_time < 0.0 || now - g_pacing_hz_read_time > PACING_HZ_REFRESH_S) {
+        g_pacing_hz_read_time = now;
+        ETrackedPropertyError err = TrackedProp_Success;
+        float hz = g_vrs ? g_vrs->GetFloatTrackedDeviceProperty(
+                               k_unTrackedDeviceIndex_Hmd, Prop_DisplayFrequency_Float, &err)
+                         : 0.0f;
+        g_pacing_hz = (err == TrackedProp_Success && hz > 1.0f) ? hz : PACING_DEFAULT_HZ;
+    }
+    return g_pacing_hz;
+}
 
-    ID3D11Device* device = (ID3D11Device*)device_ptr;
+static void pacing_sleep_until(double target, double max_slack) {
+    double slack = g_pacing_sleep_slack_s < max_slack ? g_pacing_sleep_slack_s : max_slack;
+    for (;;) {
+        double now = now_seconds();
+        double remaining = target - now;
+        if (remaining <= 0.0) return;
+
+        double sleep_s = remaining - slack - PACING_SPIN_S;
+        if (sleep_s <= 0.0) {
+            std::this_thread::yield();
+            continue;
+        }
+        std::this_thread::sleep_for(std::chrono::duration<double>(sleep_s));
+        double late = now_seconds() - (now + sleep_s);
+        g_pacing_sleep_slack_s += PACING_EMA_WEIGHT * (late - g_pacing_sleep_slack_s);
+    }
+}
 
-    for (int i = 0; i < 2; i++) {
-        if (FAILED(device->CreateTexture2D(&desc, nullptr, &g_keyboard_textures[i])))
-            return false;
-        if (FAILED(device->CreateRenderTargetView(g_keyboard_textures[i], nullptr, &g_keyboard_rtvs[i])))
-            return false;
+extern "C" void vr_wait_frame() {
+    double now = now_seconds();
+    if (g_pacing_wake_time >= 0.0) {
+        g_pacing_work_s += PACING_EMA_WEIGHT * ((now - g_pacing_wake_time) - g_pacing_work_s);
     }
 
-    // Create separate ImGui context for keyboard
-    g_keyboard_imgui_ctx = ImGui::CreateContext();
-    ImGui::SetCurrentContext(g_keyboard_imgui_ctx);
+    double period = 1.0 / pacing_display_hz();
+    float since_vsync = 0.0f;
+    uint64_t vsync = 0;
+    if (!g_vrs || !g_vrs->GetTimeSinceLastVsync(&since_vsync, &vsync)) {
+        // No vsync timing yet (compositor starting); just hold the display rate
+        double target = g_pacing_wake_time >= 0.0 ? g_pacing_wake_time + period : now;
+        pacing_sleep_until(target, period * 0.5);
+        record_pacing_wake(now);
+        return;
+    }
 
-    ImGuiIO& io = ImGui::GetIO();
-    io.DisplaySize = ImVec2((float)width, (float)height);
+    double lead = g_pacing_work_s;
+    if (lead < PACING_MIN_LEAD_S) lead = PACING_MIN_LEAD_S;
+    if (lead > period * 0.5) lead = period * 0.5;
+
+    // Serve the vsync that ends the current frame, or the one after if we
+    // already woke for it. If its wake point has passed, return right away.
+    uint64_t target_vsync = vsync + 1;
+    double wait = period - since_vsync - lead;
+    if (g_pacing_has_served && target_vsync == g_pacing_served_vsync) {
+        target_vsync++;
+        wait += period;
+    }
+    g_pacing_served_vsync = target_vsync;
+    g_pacing_has_served = true;
 
-    ImGui::StyleColorsDark();
-    ImGuiStyle& style = ImGui::GetStyle();
-    style.ScaleAllSizes(2.0f);  // Larger for VR
-    io.FontGlobalScale = 2.0f;
+    if (wait > 0.0) pacing_sleep_until(now + wait, period * 0.5);
+    record_pacing_wake(now);
+}
 
-    ImGui_ImplDX11_Init(device, (ID3D11DeviceContext*)context_ptr);
+// Scene-application frame gate, kept for MAOWBOT_OVERLAY_PACING=scene.
+// Overlays should use vr_wait_frame instead.
+extern "C" void vr_wait_get_poses() {
+    double entered = now_seconds();
+    if (auto* comp = VRCompositor()) {
+        TrackedDevicePose_t poses[k_unMaxTrackedDeviceCount];
+        comp->WaitGetPoses(poses, k_unMaxTrackedDeviceCount, nullptr, 0);
+    }
+    record_pacing_wake(entered);
+}
 
-    // Switch back to main context
-    ImGui::SetCurrentContext(g_imgui_ctx);
+// Add keyboard initialization
+extern "C" bool vr_keyboard_init_rendering(void* device_ptr, void* context_ptr) {
+    // Keyboard targets come from the pool on imgui_init's device, acquired
+    // when the keyboard first renders
+    if (!backend_ready()) return false;
+
+    // Drawn on the main context with its font atlas and backend
+    if (!g_imgui_ctx) return false;
+    if (!g_keyboard_draw_list) {
+        g_keyboard_draw_list = IM_NEW(ImDrawList)(ImGui::GetDrawListSharedData());
+    }
 
     return true;
 }
 
-// Keyboard rendering with key layout
-extern "C" bool vr_keyboard_render(VROverlayHandle_t handle,
-                                  float selected_x, float selected_y,
-                                  const char* current_text) {
-    if (handle == k_ulOverlayHandleInvalid) return false;
-
-    // Switch to keyboard context
-    ImGui::SetCurrentContext(g_keyboard_imgui_ctx);
+// ─────────────────────────── Keyboard Drawing ──────────────────────────
+// The keyboard is drawn straight into its own draw list on the main ImGui
+// context and handed to the same backend as a separate ImDrawData. It shares
+// the font atlas and device objects with the HUD and dashboard, and since it
+// never runs an ImGui frame it can't disturb the chat window's focus.
+static void draw_keyboard_key(ImDrawList* dl, ImFont* font, float font_size,
+                              float x, float y, float w, float h,
+                              const char* label, bool hovered, const ImVec4& hover_color) {
+    ImU32 bg = hovered ? ImGui::ColorConvertFloat4ToU32(hover_color)
+                       : ImGui::GetColorU32(ImGuiCol_Button);
+    dl->AddRectFilled(ImVec2(x, y), ImVec2(x + w, y + h), bg);
+
+    ImVec2 text_size = font->CalcTextSizeA(font_size, FLT_MAX, 0.0f, label);
+    dl->AddText(font, font_size, ImVec2(x + (w - text_size.x) * 0.5f, y + (h - text_size.y) * 0.5f),
+                ImGui::GetColorU32(ImGuiCol_Text), label);
+}
 
-    ImGui_ImplDX11_NewFrame();
-    ImGui::NewFrame();
+static void build_keyboard_draw_list(ImDrawList* dl, float selected_x, float selected_y,
+                                     const char* current_text) {
+    ImFont* font = ImGui::GetFont();
+    const float font_size = font->FontSize * KEYBOARD_UI_SCALE;
+    const float padding = 8.0f * KEYBOARD_UI_SCALE;
+    const ImVec4 key_hover(0.3f, 0.7f, 1.0f, 1.0f);
 
-    // Clear background
-    float clear_color[4] = { 0.1f, 0.1f, 0.1f, 0.95f };
-    g_context->ClearRenderTargetView(g_keyboard_rtvs[g_keyboard_current_tex], clear_color);
+    dl->_ResetForNewFrame();
+    dl->PushClipRect(ImVec2(0, 0), ImVec2(KEYBOARD_WIDTH, KEYBOARD_HEIGHT));
+    dl->PushTextureID(ImGui::GetIO().Fonts->TexID);
 
-    // Render keyboard UI
-    ImGui::SetNextWindowPos(ImVec2(0, 0));
-    ImGui::SetNextWindowSize(ImVec2(512, 384));
-    ImGui::Begin("Keyboard", nullptr,
-        ImGuiWindowFlags_NoTitleBar |
-        ImGuiWindowFlags_NoResize |
-        ImGuiWindowFlags_NoMove |
-        ImGuiWindowFlags_NoScrollbar);
+    dl->AddRectFilled(ImVec2(0, 0), ImVec2(KEYBOARD_WIDTH, KEYBOARD_HEIGHT),
+                      ImGui::GetColorU32(ImGuiCol_WindowBg));
 
     // Current text with cursor
-    ImGui::Text("Text: %s_", current_text ? current_text : "");
-    ImGui::Separator();
+    char line[300];
+    snprintf(line, sizeof(line), "Text: %s_", current_text ? current_text : "");
+    dl->AddText(font, font_size, ImVec2(padding, padding), ImGui::GetColorU32(ImGuiCol_Text), line);
+    float separator_y = padding + font_size + 4.0f * KEYBOARD_UI_SCALE;
+    dl->AddLine(ImVec2(padding, separator_y), ImVec2(KEYBOARD_WIDTH - padding, separator_y),
+                ImGui::GetColorU32(ImGuiCol_Separator));
 
     // Draw keyboard buttons
     const char* rows[] = {
@@ -371,152 +2160,421 @@ extern "C" bool vr_keyboard_render(VROverlayHandle_t handle,
     float button_size = 35.0f;
     float spacing = 2.0f;
 
-    // Track if we're hovering over any button
-    bool any_hovered = false;
-
     for (int row = 0; row < 4; row++) {
         float x_offset = 10.0f + (row == 3 ? 30.0f : row * 15.0f);
         float y_offset = 80.0f + row * (button_size + spacing);
 
-        ImGui::SetCursorPos(ImVec2(x_offset, y_offset));
-
         for (int i = 0; rows[row][i]; i++) {
-            if (i > 0) ImGui::SameLine(0, spacing);
-
-            char label[2] = { toupper(rows[row][i]), 0 };
+            char label[2] = { (char)toupper(rows[row][i]), 0 };
 
             // Calculate button bounds
             float btn_x = x_offset + i * (button_size + spacing);
             float btn_y = y_offset;
 
-            // Fix the coordinate check - selected_x and selected_y are already in correct coordinates
+            // selected_x and selected_y are already in keyboard texture coordinates
             bool is_hovered = (selected_x >= btn_x &&
                              selected_x <= btn_x + button_size &&
                              selected_y >= btn_y &&
                              selected_y <= btn_y + button_size);
 
-            if (is_hovered) {
-                any_hovered = true;
-                ImGui::PushStyleColor(ImGuiCol_Button, ImVec4(0.3f, 0.7f, 1.0f, 1.0f));
-                ImGui::PushStyleColor(ImGuiCol_ButtonHovered, ImVec4(0.4f, 0.8f, 1.0f, 1.0f));
-            }
-
-            if (ImGui::Button(label, ImVec2(button_size, button_size))) {
-                // Button was clicked (this won't happen with VR input, but good for testing)
-            }
-
-            if (is_hovered) {
-                ImGui::PopStyleColor(2);
-            }
+            draw_keyboard_key(dl, font, font_size, btn_x, btn_y, button_size, button_size,
+                              label, is_hovered, key_hover);
         }
     }
 
     // Special keys
     float special_y = 80.0f + 4 * (button_size + spacing) + 10.0f;
 
-    ImGui::SetCursorPos(ImVec2(100.0f, special_y));
     bool space_hovered = (selected_x >= 100.0f && selected_x <= 300.0f &&
                          selected_y >= special_y && selected_y <= special_y + button_size);
-    if (space_hovered) {
-        ImGui::PushStyleColor(ImGuiCol_Button, ImVec4(0.3f, 0.7f, 1.0f, 1.0f));
-        any_hovered = true;
-    }
-    ImGui::Button("Space", ImVec2(200.0f, button_size));
-    if (space_hovered) ImGui::PopStyleColor();
+    draw_keyboard_key(dl, font, font_size, 100.0f, special_y, 200.0f, button_size,
+                      "Space", space_hovered, key_hover);
 
-    ImGui::SameLine(0, spacing);
     bool back_hovered = (selected_x >= 302.0f && selected_x <= 402.0f &&
                         selected_y >= special_y && selected_y <= special_y + button_size);
-    if (back_hovered) {
-        ImGui::PushStyleColor(ImGuiCol_Button, ImVec4(1.0f, 0.3f, 0.3f, 1.0f));
-        any_hovered = true;
-    }
-    ImGui::Button("Back", ImVec2(100.0f, button_size));
-    if (back_hovered) ImGui::PopStyleColor();
+    draw_keyboard_key(dl, font, font_size, 302.0f, special_y, 100.0f, button_size,
+                      "Back", back_hovered, ImVec4(1.0f, 0.3f, 0.3f, 1.0f));
 
-    ImGui::SameLine(0, spacing);
     bool enter_hovered = (selected_x >= 404.0f && selected_x <= 484.0f &&
                          selected_y >= special_y && selected_y <= special_y + button_size);
-    if (enter_hovered) {
-        ImGui::PushStyleColor(ImGuiCol_Button, ImVec4(0.3f, 1.0f, 0.3f, 1.0f));
-        any_hovered = true;
-    }
-    ImGui::Button("Enter", ImVec2(80.0f, button_size));
-    if (enter_hovered) ImGui::PopStyleColor();
+    draw_keyboard_key(dl, font, font_size, 404.0f, special_y, 80.0f, button_size,
+                      "Enter", enter_hovered, ImVec4(0.3f, 1.0f, 0.3f, 1.0f));
 
     // Draw laser pointer on keyboard
     if (selected_x >= 0 && selected_y >= 0) {
-        ImDrawList* draw_list = ImGui::GetWindowDrawList();
         ImU32 color = IM_COL32(255, 100, 100, 255);
-        draw_list->AddCircleFilled(ImVec2(selected_x, selected_y), 5.0f, color);
-        draw_list->AddCircle(ImVec2(selected_x, selected_y), 8.0f, IM_COL32(255, 255, 255, 200), 0, 2.0f);
+        dl->AddCircleFilled(ImVec2(selected_x, selected_y), 5.0f, color);
+        dl->AddCircle(ImVec2(selected_x, selected_y), 8.0f, IM_COL32(255, 255, 255, 200), 0, 2.0f);
     }
 
-    ImGui::End();
+    dl->PopTextureID();
+    dl->PopClipRect();
+}
 
-    // Render
-    ImGui::Render();
-    g_context->OMSetRenderTargets(1, &g_keyboard_rtvs[g_keyboard_current_tex], nullptr);
+static void fill_keyboard_draw_data(ImDrawData& draw_data) {
+    draw_data.Clear();
+    draw_data.Valid = true;
+    draw_data.DisplayPos = ImVec2(0.0f, 0.0f);
+    draw_data.DisplaySize = ImVec2(KEYBOARD_WIDTH, KEYBOARD_HEIGHT);
+    draw_data.FramebufferScale = ImVec2(1.0f, 1.0f);
+    draw_data.AddDrawList(g_keyboard_draw_list);
+}
 
-    D3D11_VIEWPORT vp = {};
-    vp.Width = 512.0f;
-    vp.Height = 384.0f;
-    vp.MaxDepth = 1.0f;
-    g_context->RSSetViewports(1, &vp);
+// Keyboard rendering with key layout
+extern "C" bool vr_keyboard_render(VROverlayHandle_t handle,
+                                  float selected_x, float selected_y,
+                                  const char* current_text) {
+    if (handle == k_ulOverlayHandleInvalid) return false;
 
-    ImGui_ImplDX11_RenderDrawData(ImGui::GetDrawData());
+    // The keyboard only changes with the pointer position and typed text
+    static float last_selected_x = -2.0f;
+    static float last_selected_y = -2.0f;
+    static char last_text[256] = {0};
+    const char* text = current_text ? current_text : "";
+    if (selected_x != last_selected_x || selected_y != last_selected_y ||
+        strncmp(text, last_text, sizeof(last_text) - 1) != 0) {
+        last_selected_x = selected_x;
+        last_selected_y = selected_y;
+        strncpy(last_text, text, sizeof(last_text) - 1);
+        mark_dirty(g_keyboard_retained);
+    }
+    if (!g_imgui_frame_ready || !g_keyboard_draw_list) return true;
+    bool laser_on_keyboard = selected_x >= 0 && selected_y >= 0;
+    if (!schedule_due(OVERLAY_KEYBOARD, laser_on_keyboard)) return true;
+    if (!needs_render(g_keyboard_retained)) return true;
 
-    // Submit to OpenVR
-    Texture_t vr_tex = {};
-    vr_tex.handle = g_keyboard_textures[g_keyboard_current_tex];
-    vr_tex.eType = TextureType_DirectX;
-    vr_tex.eColorSpace = ColorSpace_Gamma;
+    if (!swapchain_acquire(g_keyboard_swapchain, (uint32_t)KEYBOARD_WIDTH, (uint32_t)KEYBOARD_HEIGHT,
+                           g_quality[OVERLAY_KEYBOARD])) {
+        return false;
+    }
+    RenderTarget* target = swapchain_target(g_keyboard_swapchain);
+    if (!target) {
+        mark_dirty(g_keyboard_retained);  // GPU still busy; retry next frame
+        return true;
+    }
 
-    VROverlayError err = VROverlay()->SetOverlayTexture(handle, &vr_tex);
+    double ui_start = now_seconds();
+    AllocationMark ui_allocs = allocation_mark();
+    build_keyboard_draw_list(g_keyboard_draw_list, selected_x, selected_y, current_text);
+    record_stage(STAGE_UI, ui_start);
+    record_allocations(ui_allocs);
 
-    g_keyboard_current_tex = (g_keyboard_current_tex + 1) % 2;
+    double draw_start = now_seconds();
+    int gpu_timer = gpu_timer_begin();
 
-    // Switch back to main context
-    ImGui::SetCurrentContext(g_imgui_ctx);
+    // Clear background
+    backend_bind_target(target);
+    float clear_color[4] = { 0.1f, 0.1f, 0.1f, 0.95f };
+    backend_clear_target(target, clear_color, nullptr);
+
+    static ImDrawData draw_data;  // Reused; its list array would be allocated every render
+    fill_keyboard_draw_data(draw_data);
+    scale_draw_data(&draw_data, g_keyboard_swapchain.scale);
+    backend_render_draw_data(&draw_data);
+    backend_resolve_target(target);
+    gpu_timer_end(gpu_timer);
+    record_stage(STAGE_DRAW, draw_start);
+
+    // Submit to OpenVR
+    double submit_start = now_seconds();
+    VROverlayError err = backend_submit_target(handle, target);
+    record_stage(STAGE_SUBMIT, submit_start);
+
+    swapchain_advance(g_keyboard_swapchain);
 
     return err == VROverlayError_None;
 }
 
-// ─────────────────────────── Controller Functions ──────────────────────
-extern "C" void vr_update_controllers() {
-    TrackedDevicePose_t poses[k_unMaxTrackedDeviceCount];
-    g_vrc->GetLastPoses(poses, k_unMaxTrackedDeviceCount, nullptr, 0);
+// Render-thread counterpart of vr_keyboard_render: stage the keyboard for the
+// next published snapshot. Post an invalid handle while it is hidden.
+extern "C" void vr_keyboard_post(VROverlayHandle_t handle,
+                                 float selected_x, float selected_y,
+                                 const char* current_text) {
+    g_input_staging.keyboard_handle = handle;
+    g_input_staging.keyboard_selected_x = selected_x;
+    g_input_staging.keyboard_selected_y = selected_y;
+    strncpy(g_input_staging.keyboard_text, current_text ? current_text : "",
+            sizeof(g_input_staging.keyboard_text) - 1);
+}
+
+// ─────────────────────────── Tracked Device Cache ──────────────────────
+// Device classes and controller roles only change when vrserver says so, so
+// they are cached here and re-read on activation/deactivation/role events
+// instead of being queried for every device slot on every frame.
+struct TrackedDeviceInfo {
+    ETrackedDeviceClass device_class = TrackedDeviceClass_Invalid;
+    ETrackedControllerRole role = TrackedControllerRole_Invalid;
+    int hip_hint = 0;   // HIP_HINT_* for generic trackers
+};
+
+static TrackedDeviceInfo g_devices[k_unMaxTrackedDeviceCount];
+static TrackedDeviceIndex_t g_controller_devices[2] = {k_unTrackedDeviceIndexInvalid,
+                                                       k_unTrackedDeviceIndexInvalid};
+static bool g_devices_dirty = true;
+
+// ─────────────────────────── Hip Tracker ───────────────────────────────
+// The hip tracker is re-resolved when the device table changes. An explicit
+// serial wins, then a waist/hip role assigned in SteamVR, then any tracker at
+// hip height. Height needs a valid pose, so while trackers exist but none has
+// qualified yet, the check is repeated against each frame's pose array.
+enum {
+    HIP_HINT_NONE = 0,
+    HIP_HINT_HEIGHT = 1,
+    HIP_HINT_ROLE = 2,
+    HIP_HINT_SERIAL = 3,
+};
+
+static char g_hip_serial_hint[64] = {0};
+static TrackedDeviceIndex_t g_hip_tracker = k_unTrackedDeviceIndexInvalid;
+static bool g_hip_tracker_changed = false;
+static bool g_hip_resolve_pending = false;
+
+static bool tracked_string_property(TrackedDeviceIndex_t i, ETrackedDeviceProperty prop,
+                                    char* buffer, uint32_t capacity) {
+    ETrackedPropertyError err = TrackedProp_Success;
+    g_vrs->GetStringTrackedDeviceProperty(i, prop, buffer, capacity, &err);
+    if (err != TrackedProp_Success) buffer[0] = 0;
+    return err == TrackedProp_Success;
+}
+
+// Role and serial hints come from device properties, so they are only read
+// when the device table is rebuilt
+static int read_hip_hint(TrackedDeviceIndex_t i) {
+    char value[128];
+    if (g_hip_serial_hint[0] &&
+        tracked_string_property(i, Prop_SerialNumber_String, value, sizeof(value)) &&
+        strcmp(value, g_hip_serial_hint) == 0) {
+        return HIP_HINT_SERIAL;
+    }
+
+    // Trackers with an assigned role report e.g. "vive_tracker_waist"
+    if (tracked_string_property(i, Prop_ControllerType_String, value, sizeof(value))) {
+        for (char* c = value; *c; c++) *c = (char)tolower((unsigned char)*c);
+        if (strstr(value, "waist") || strstr(value, "hip")) return HIP_HINT_ROLE;
+    }
+    return HIP_HINT_NONE;
+}
+
+static void resolve_hip_tracker(const TrackedDevicePose_t* poses) {
+    TrackedDeviceIndex_t best = k_unTrackedDeviceIndexInvalid;
+    int best_hint = HIP_HINT_NONE;
+    bool any_tracker = false;
 
-    // Find and update controllers
     for (uint32_t i = 0; i < k_unMaxTrackedDeviceCount; i++) {
-        if (g_vrs->GetTrackedDeviceClass(i) == TrackedDeviceClass_Controller) {
-            ETrackedControllerRole role = g_vrs->GetControllerRoleForTrackedDeviceIndex(i);
-            if (role == TrackedControllerRole_Invalid) continue;
+        if (g_devices[i].device_class != TrackedDeviceClass_GenericTracker) continue;
+        any_tracker = true;
+
+        int hint = g_devices[i].hip_hint;
+        if (hint == HIP_HINT_NONE && poses[i].bPoseIsValid) {
+            float y = poses[i].mDeviceToAbsoluteTracking.m[1][3];
+            // Hip trackers are typically 0.8-1.2m high
+            if (y > 0.8f && y < 1.2f) hint = HIP_HINT_HEIGHT;
+        }
+        if (hint > best_hint) {
+            best = i;
+            best_hint = hint;
+        }
+    }
 
-            int idx = (role == TrackedControllerRole_LeftHand) ? 0 : 1;
+    // Keep a tracker that temporarily lost its pose rather than flapping
+    bool current_still_tracker = g_hip_tracker != k_unTrackedDeviceIndexInvalid &&
+        g_devices[g_hip_tracker].device_class == TrackedDeviceClass_GenericTracker;
+    if (best == k_unTrackedDeviceIndexInvalid && current_still_tracker) {
+        best = g_hip_tracker;
+    }
 
-            g_controllers[idx].device_index = i;
-            g_controllers[idx].connected = poses[i].bDeviceIsConnected;
-            g_controllers[idx].has_pose = poses[i].bPoseIsValid;
+    if (best != g_hip_tracker) {
+        g_hip_tracker = best;
+        g_hip_tracker_changed = true;
+    }
+    g_hip_resolve_pending = any_tracker && best == k_unTrackedDeviceIndexInvalid;
+}
 
-            if (poses[i].bPoseIsValid) {
-                g_controllers[idx].pose = poses[i].mDeviceToAbsoluteTracking;
-            }
+static void rescan_tracked_devices() {
+    g_controller_devices[0] = k_unTrackedDeviceIndexInvalid;
+    g_controller_devices[1] = k_unTrackedDeviceIndexInvalid;
 
-            // Store previous state
-            g_controllers[idx].prev_state = g_controllers[idx].state;
+    for (uint32_t i = 0; i < k_unMaxTrackedDeviceCount; i++) {
+        TrackedDeviceInfo& info = g_devices[i];
+        info.device_class = g_vrs->GetTrackedDeviceClass(i);
+        info.role = info.device_class == TrackedDeviceClass_Controller
+            ? g_vrs->GetControllerRoleForTrackedDeviceIndex(i)
+            : TrackedControllerRole_Invalid;
+
+        info.hip_hint = info.device_class == TrackedDeviceClass_GenericTracker
+            ? read_hip_hint(i)
+            : HIP_HINT_NONE;
+
+        if (info.role == TrackedControllerRole_LeftHand) {
+            g_controller_devices[0] = i;
+        } else if (info.role == TrackedControllerRole_RightHand) {
+            g_controller_devices[1] = i;
+        }
+    }
+
+    g_devices_dirty = false;
+    g_hip_resolve_pending = true;
+}
+
+// ─────────────────────────── Event Pump ────────────────────────────────
+// System events and the events of every routed overlay are drained once per
+// frame, from vr_update_controllers, into one queue per overlay. Consumers
+// (vr_process_dashboard_events on the render side, vr_overlay_poll and
+// vr_dashboard_poll from Rust) read those queues, never the compositor, so
+// one overlay's input can't land in another's pointer state.
+struct EventRoute {
+    OverlayId id;
+    const VROverlayHandle_t* handle;
+    RetainedState* retained;    // Marked dirty per routed event; null if the
+                                // overlay's pointer comes from our lasers
+};
+
+static const EventRoute EVENT_ROUTES[] = {
+    { OVERLAY_HUD, &g_handle, nullptr },
+    { OVERLAY_DASHBOARD, &g_dashboard_handle, &g_dashboard_retained },
+};
+
+// Mouse moves coalesce, so the cap is only reached when nothing consumes
+// an overlay's events (e.g. the HUD's); the oldest are dropped then
+static const size_t MAX_QUEUED_OVERLAY_EVENTS = 64;
+
+struct OverlayEventQueue {
+    std::mutex mutex;
+    std::deque<VREvent_t> events;
+};
+
+static OverlayEventQueue g_overlay_events[OVERLAY_COUNT];
+
+static void queue_overlay_event(OverlayEventQueue& q, const VREvent_t& event) {
+    std::lock_guard<std::mutex> lock(q.mutex);
+    if (event.eventType == VREvent_MouseMove && !q.events.empty() &&
+        q.events.back().eventType == VREvent_MouseMove) {
+        q.events.back() = event;
+        return;
+    }
+    if (q.events.size() >= MAX_QUEUED_OVERLAY_EVENTS) q.events.pop_front();
+    q.events.push_back(event);
+}
+
+static bool take_overlay_event(OverlayId id, VREvent_t* event) {
+    OverlayEventQueue& q = g_overlay_events[id];
+    std::lock_guard<std::mutex> lock(q.mutex);
+    if (q.events.empty()) return false;
+    *event = q.events.front();
+    q.events.pop_front();
+    return true;
+}
+
+// Apply an overlay's queued mouse events to its pointer; true if any were
+// queued. A release following a press taken in the same call stays queued
+// for the next frame, so ImGui sees every click held for a frame.
+static bool drain_pointer_events(OverlayId id, OverlayPointer& pointer) {
+    OverlayEventQueue& q = g_overlay_events[id];
+    std::lock_guard<std::mutex> lock(q.mutex);
+    bool any = !q.events.empty();
+    bool pressed = false;
+    while (!q.events.empty()) {
+        const VREvent_t& event = q.events.front();
+        bool left = event.data.mouse.button == VRMouseButton_Left;
+        if (event.eventType == VREvent_MouseButtonUp && left && pressed) break;
+
+        switch (event.eventType) {
+            case VREvent_MouseMove:
+                pointer.x = event.data.mouse.x;
+                pointer.y = event.data.mouse.y;
+                break;
+            case VREvent_MouseButtonDown:
+                if (left) pointer.down = pressed = true;
+                break;
+            case VREvent_MouseButtonUp:
+                if (left) pointer.down = false;
+                break;
+        }
+        q.events.pop_front();
+    }
+    return any;
+}
+
+static void pump_events() {
+    VREvent_t event;
+    while (g_vrs->PollNextEvent(&event, sizeof(event))) {
+        switch (event.eventType) {
+            case VREvent_TrackedDeviceActivated:
+            case VREvent_TrackedDeviceDeactivated:
+            case VREvent_TrackedDeviceRoleChanged:
+                g_devices_dirty = true;
+                break;
+        }
+    }
+
+    for (const EventRoute& route : EVENT_ROUTES) {
+        VROverlayHandle_t handle = *route.handle;
+        if (handle == k_ulOverlayHandleInvalid) continue;
+        bool routed = false;
+        while (g_vro->PollNextOverlayEvent(handle, &event, sizeof(event))) {
+            queue_overlay_event(g_overlay_events[route.id], event);
+            routed = true;
+        }
+        if (routed && route.retained) mark_dirty(*route.retained);
+    }
+}
+
+extern "C" bool vr_overlay_poll(VREvent_t* e) {
+    return take_overlay_event(OVERLAY_HUD, e);
+}
+
+extern "C" bool vr_dashboard_poll(VREvent_t* e) {
+    return take_overlay_event(OVERLAY_DASHBOARD, e);
+}
+
+// ─────────────────────────── Controller Functions ──────────────────────
+extern "C" void vr_update_controllers() {
+    double start = now_seconds();
+    pump_events();
+    if (g_devices_dirty) rescan_tracked_devices();
+
+    TrackedDevicePose_t* poses = g_device_poses;
+    g_vrc->GetLastPoses(poses, k_unMaxTrackedDeviceCount, nullptr, 0);
 
-            // Get current state
-            g_vrs->GetControllerState(i, &g_controllers[idx].state, sizeof(VRControllerState_t));
+    if (g_hip_resolve_pending) resolve_hip_tracker(poses);
+    sync_hud_overlay_size();
+    update_alerts();
+    update_registry_view();
+
+    // Only the two known controller slots are touched per frame
+    for (int idx = 0; idx < 2; idx++) {
+        TrackedDeviceIndex_t i = g_controller_devices[idx];
+        if (i == k_unTrackedDeviceIndexInvalid) {
+            g_controllers[idx].device_index = k_unTrackedDeviceIndexInvalid;
+            g_controllers[idx].connected = false;
+            g_controllers[idx].has_pose = false;
+            g_controllers[idx].trigger_pressed = false;
+            g_controllers[idx].trigger_released = false;
+            continue;
+        }
 
-            // Check trigger state changes
-            bool was_pressed = g_controllers[idx].prev_state.rAxis[1].x > 0.5f;
-            bool is_pressed = g_controllers[idx].state.rAxis[1].x > 0.5f;
+        g_controllers[idx].device_index = i;
+        g_controllers[idx].connected = poses[i].bDeviceIsConnected;
+        g_controllers[idx].has_pose = poses[i].bPoseIsValid;
 
-            g_controllers[idx].trigger_pressed = !was_pressed && is_pressed;
-            g_controllers[idx].trigger_released = was_pressed && !is_pressed;
+        if (poses[i].bPoseIsValid) {
+            g_controllers[idx].pose = poses[i].mDeviceToAbsoluteTracking;
         }
+
+        // Store previous state
+        g_controllers[idx].prev_state = g_controllers[idx].state;
+
+        // Get current state
+        g_vrs->GetControllerState(i, &g_controllers[idx].state, sizeof(VRControllerState_t));
+
+        // Check trigger state changes
+        bool was_pressed = g_controllers[idx].prev_state.rAxis[1].x > 0.5f;
+        bool is_pressed = g_controllers[idx].state.rAxis[1].x > 0.5f;
+
+        g_controllers[idx].trigger_pressed = !was_pressed && is_pressed;
+        g_controllers[idx].trigger_released = was_pressed && !is_pressed;
     }
+    record_stage(STAGE_CONTROLLERS, start);
 }
 
 extern "C" bool vr_get_controller_menu_pressed(int controller_idx) {
@@ -546,20 +2604,59 @@ extern "C" bool vr_get_controller_trigger_released(int controller_idx) {
     return g_controllers[controller_idx].trigger_released;
 }
 
+// ─────────────────────────── Laser Intersection ────────────────────────
+struct LaserBatchHit {
+    bool hit;
+    uint32_t overlay_index;   // Index into the overlays array of the nearest hit
+    float u, v;
+    float distance;
+};
+
+static const size_t MAX_LASER_BATCH_OVERLAYS = 8;
+// The prune box is the overlay's cached width by width * aspect (height over
+// width), widened by this slack so hits along the edges are never pruned
+static const float LASER_PRUNE_MARGIN = 1.1f;
+
+// Controller tip and forward direction (-Z in controller space)
+static bool controller_ray(int controller_idx, HmdVector3_t& origin, HmdVector3_t& direction) {
+    if (controller_idx < 0 || controller_idx > 1) return false;
+    if (!g_controllers[controller_idx].connected) return false;
+    if (!g_controllers[controller_idx].has_pose) return false;
+
+    const HmdMatrix34_t& pose = g_controllers[controller_idx].pose;
+    origin = {pose.m[0][3], pose.m[1][3], pose.m[2][3]};
+    direction = {-pose.m[0][2], -pose.m[1][2], -pose.m[2][2]};
+    return true;
+}
+
+// Cheap rejection: the ray has to cross the overlay's plane in front of the
+// controller and, when the width is known, land near the overlay
+static bool laser_may_hit(const HmdVector3_t& o, const HmdVector3_t& d,
+                          const HmdMatrix34_t& w, float width_m, float aspect) {
+    float nx = w.m[0][2], ny = w.m[1][2], nz = w.m[2][2];
+    float denom = d.v[0] * nx + d.v[1] * ny + d.v[2] * nz;
+    if (fabsf(denom) < 1e-6f) return false;
+
+    float ox = w.m[0][3] - o.v[0], oy = w.m[1][3] - o.v[1], oz = w.m[2][3] - o.v[2];
+    float t = (ox * nx + oy * ny + oz * nz) / denom;
+    if (t <= 0.0f) return false;
+    if (width_m <= 0.0f) return true;
+
+    // Hit point relative to the overlay centre, projected on its X/Y axes
+    float hx = d.v[0] * t - ox, hy = d.v[1] * t - oy, hz = d.v[2] * t - oz;
+    float lx = hx * w.m[0][0] + hy * w.m[1][0] + hz * w.m[2][0];
+    float ly = hx * w.m[0][1] + hy * w.m[1][1] + hz * w.m[2][1];
+    float half = width_m * 0.5f * LASER_PRUNE_MARGIN;
+    return fabsf(lx) <= half && fabsf(ly) <= half * aspect;
+}
+
 extern "C" LaserHit vr_test_laser_intersection(int controller_idx, VROverlayHandle_t handle) {
     LaserHit result = {false, 0, 0, FLT_MAX};
 
-    if (controller_idx < 0 || controller_idx > 1) return result;
-    if (!g_controllers[controller_idx].connected) return result;
-    if (!g_controllers[controller_idx].has_pose) return result;
+    HmdVector3_t origin, direction;
+    if (!controller_ray(controller_idx, origin, direction)) return result;
     if (handle == k_ulOverlayHandleInvalid) return result;
 
-    // Get controller tip position and forward direction
-    HmdMatrix34_t& pose = g_controllers[controller_idx].pose;
-    HmdVector3_t origin = {pose.m[0][3], pose.m[1][3], pose.m[2][3]};
-    // Forward is -Z in controller space
-    HmdVector3_t direction = {-pose.m[0][2], -pose.m[1][2], -pose.m[2][2]};
-
     VROverlayIntersectionParams_t params;
     params.eOrigin = TrackingUniverseStanding;
     params.vSource = origin;
@@ -573,79 +2670,581 @@ extern "C" LaserHit vr_test_laser_intersection(int controller_idx, VROverlayHand
         result.distance = results.fDistance;
     }
 
-    return result;
+    return result;
+}
+
+// Test every controller against every overlay in one call. Each ray is built
+// once, overlays that are hidden or can't be hit are rejected on the CPU, and
+// out_hits[i] gets the nearest hit for controllers[i]. Returns the number of
+// controllers that hit something.
+extern "C" size_t vr_test_laser_batch(const int* controllers, size_t controller_count,
+                                      const VROverlayHandle_t* overlays, size_t overlay_count,
+                                      LaserBatchHit* out_hits) {
+    if (!controllers || !out_hits) return 0;
+    if (!overlays) overlay_count = 0;
+    if (overlay_count > MAX_LASER_BATCH_OVERLAYS) overlay_count = MAX_LASER_BATCH_OVERLAYS;
+
+    // Resolve each overlay's placement once for all rays
+    bool skip[MAX_LASER_BATCH_OVERLAYS];
+    bool known[MAX_LASER_BATCH_OVERLAYS];
+    float width[MAX_LASER_BATCH_OVERLAYS];
+    float aspect[MAX_LASER_BATCH_OVERLAYS];
+    HmdMatrix34_t world[MAX_LASER_BATCH_OVERLAYS];
+    for (size_t j = 0; j < overlay_count; j++) {
+        const OverlayPlacement* p = find_placement(overlays[j], false);
+        skip[j] = overlays[j] == k_ulOverlayHandleInvalid || (p && !p->visible);
+        known[j] = p && placement_world_transform(*p, world[j]);
+        width[j] = p ? p->width_m : 0.0f;
+        aspect[j] = p ? p->aspect : 1.0f;
+    }
+
+    size_t hit_count = 0;
+    for (size_t i = 0; i < controller_count; i++) {
+        LaserBatchHit& out = out_hits[i];
+        out = {false, UINT32_MAX, 0.0f, 0.0f, FLT_MAX};
+
+        HmdVector3_t origin, direction;
+        if (!controller_ray(controllers[i], origin, direction)) continue;
+
+        VROverlayIntersectionParams_t params;
+        params.eOrigin = TrackingUniverseStanding;
+        params.vSource = origin;
+        params.vDirection = direction;
+
+        for (size_t j = 0; j < overlay_count; j++) {
+            if (skip[j]) continue;
+            if (known[j] && !laser_may_hit(origin, direction, world[j], width[j], aspect[j])) continue;
+
+            VROverlayIntersectionResults_t results;
+            if (g_vro->ComputeOverlayIntersection(overlays[j], &params, &results) &&
+                results.fDistance < out.distance) {
+                out.hit = true;
+                out.overlay_index = (uint32_t)j;
+                out.u = results.vUVs.v[0];
+                out.v = results.vUVs.v[1];
+                out.distance = results.fDistance;
+            }
+        }
+        if (out.hit) hit_count++;
+    }
+    return hit_count;
+}
+
+extern "C" VROverlayHandle_t vr_get_hud_overlay_handle() {
+    return g_handle;
+}
+
+// Default test with main overlay
+extern "C" LaserHit vr_test_laser_intersection_main(int controller_idx) {
+    return vr_test_laser_intersection(controller_idx, g_handle);
+}
+
+extern "C" void vr_trigger_haptic_pulse(int controller_idx, unsigned short duration_us) {
+    if (controller_idx < 0 || controller_idx > 1) return;
+    if (!g_controllers[controller_idx].connected) return;
+
+    g_vrs->TriggerHapticPulse(g_controllers[controller_idx].device_index, 0, duration_us);
+}
+
+// Returns true (once) after the hip tracker changed, including when it was lost
+extern "C" bool vr_get_hip_tracker_changed(uint32_t* index) {
+    if (index && g_hip_tracker_changed) {
+        *index = g_hip_tracker;
+        g_hip_tracker_changed = false;
+        return true;
+    }
+    return false;
+}
+
+// Serial of the tracker to prefer as the hip tracker; empty or null clears it
+extern "C" void vr_set_hip_tracker_serial(const char* serial) {
+    strncpy(g_hip_serial_hint, serial ? serial : "", sizeof(g_hip_serial_hint) - 1);
+    g_hip_serial_hint[sizeof(g_hip_serial_hint) - 1] = 0;
+    g_devices_dirty = true;
+}
+
+// ─────────────────────────── Emote Atlas ───────────────────────────────
+// Chat words naming a registered emote are drawn as images from one atlas
+// texture. Rust hands over decoded RGBA (vr_emote_register); a worker thread
+// fits each image into an atlas cell, so the render side never scales pixels.
+// The render side keeps every fitted emote in memory but only the ones recently
+// drawn in the atlas: an emote drawn while not resident shows a placeholder and
+// is queued, and at most EMOTE_UPLOADS_PER_FRAME cells are uploaded before each
+// HUD render, taking a free cell or the least recently drawn one that the last
+// chat list didn't show.
+static const uint32_t EMOTE_ATLAS_SIZE = 1024;
+static const uint32_t EMOTE_CELL_SIZE = 64;
+static const uint32_t EMOTE_CELL_PADDING = 1;     // Transparent border against filter bleed
+static const uint32_t EMOTE_CELLS_PER_ROW = EMOTE_ATLAS_SIZE / EMOTE_CELL_SIZE;
+static const int EMOTE_CELL_COUNT = (int)(EMOTE_CELLS_PER_ROW * EMOTE_CELLS_PER_ROW);
+static const int EMOTE_UPLOADS_PER_FRAME = 4;
+static const size_t EMOTE_MAX_KNOWN = 1024;        // Fitted copies kept in memory
+static const size_t EMOTE_QUEUE_MAX = 256;         // Registrations waiting for the worker
+static const uint32_t EMOTE_MAX_SOURCE_SIZE = 1024;
+static const float EMOTE_MAX_ASPECT = 3.0f;
+
+struct EmoteJob {
+    std::string name;
+    std::vector<uint8_t> rgba;
+    uint32_t width;
+    uint32_t height;
+};
+
+struct FittedEmote {
+    std::string name;
+    std::vector<uint8_t> pixels;   // One cell of RGBA, image at the top left
+    uint32_t width;                // Image size within the cell
+    uint32_t height;
+};
+
+struct Emote {
+    std::vector<uint8_t> pixels;
+    uint32_t width = 0;
+    uint32_t height = 0;
+    int cell = -1;                 // Atlas cell holding it, -1 while not resident
+    uint64_t last_drawn = 0;       // g_emote_build it was last drawn in
+    bool wanted = false;           // Queued in g_emote_wanted
+};
+
+// Worker queues, guarded by g_emote_mutex
+static std::mutex g_emote_mutex;
+static std::condition_variable g_emote_cv;
+static std::deque<EmoteJob> g_emote_jobs;
+static std::vector<FittedEmote> g_emote_fitted;
+static bool g_emote_worker_running = false;
+static std::thread g_emote_worker;
+
+// Render side only
+static std::vector<FittedEmote> g_emote_fitted_drain;
+static std::unordered_map<std::string, Emote> g_emotes;
+static std::string g_emote_lookup;               // Reused key for find_emote
+static std::vector<Emote*> g_emote_wanted;
+static Emote* g_emote_cells[EMOTE_CELL_COUNT] = {};
+static BackendTexture* g_emote_atlas = nullptr;
+static uint64_t g_emote_build = 1;               // Bumped by every chat list build
+
+// Box filter onto the cell, weighting colour by alpha so transparent
+// pixels don't darken the edges; upscaling degenerates to nearest
+static void fit_emote(const EmoteJob& job, FittedEmote& out) {
+    const uint32_t box = EMOTE_CELL_SIZE - 2 * EMOTE_CELL_PADDING;
+    float fit = fminf((float)box / (float)job.width, (float)box / (float)job.height);
+    uint32_t w = (uint32_t)fmaxf(1.0f, roundf(job.width * fit));
+    uint32_t h = (uint32_t)fmaxf(1.0f, roundf(job.height * fit));
+    if (w > box) w = box;
+    if (h > box) h = box;
+
+    out.name = job.name;
+    out.width = w;
+    out.height = h;
+    out.pixels.assign((size_t)EMOTE_CELL_SIZE * EMOTE_CELL_SIZE * 4, 0);
+
+    const float sx = (float)job.width / (float)w, sy = (float)job.height / (float)h;
+    for (uint32_t y = 0; y < h; y++) {
+        uint32_t y0 = (uint32_t)(y * sy), y1 = (uint32_t)((y + 1) * sy);
+        if (y1 <= y0) y1 = y0 + 1;
+        if (y1 > job.height) y1 = job.height;
+        for (uint32_t x = 0; x < w; x++) {
+            uint32_t x0 = (uint32_t)(x * sx), x1 = (uint32_t)((x + 1) * sx);
+            if (x1 <= x0) x1 = x0 + 1;
+            if (x1 > job.width) x1 = job.width;
+
+            float r = 0.0f, g = 0.0f, b = 0.0f, a = 0.0f;
+            for (uint32_t v = y0; v < y1; v++) {
+                const uint8_t* p = &job.rgba[((size_t)v * job.width + x0) * 4];
+                for (uint32_t u = x0; u < x1; u++, p += 4) {
+                    float pa = p[3];
+                    r += p[0] * pa; g += p[1] * pa; b += p[2] * pa; a += pa;
+                }
+            }
+            uint8_t* q = &out.pixels[(((size_t)y + EMOTE_CELL_PADDING) * EMOTE_CELL_SIZE +
+                                      x + EMOTE_CELL_PADDING) * 4];
+            if (a > 0.0f) {
+                q[0] = (uint8_t)(r / a + 0.5f);
+                q[1] = (uint8_t)(g / a + 0.5f);
+                q[2] = (uint8_t)(b / a + 0.5f);
+                q[3] = (uint8_t)(a / (float)((x1 - x0) * (y1 - y0)) + 0.5f);
+            }
+        }
+    }
+}
+
+static void emote_worker_main() {
+    std::unique_lock<std::mutex> lock(g_emote_mutex);
+    while (true) {
+        g_emote_cv.wait(lock, [] { return !g_emote_jobs.empty() || !g_emote_worker_running; });
+        if (!g_emote_worker_running) break;
+        EmoteJob job = std::move(g_emote_jobs.front());
+        g_emote_jobs.pop_front();
+
+        lock.unlock();
+        FittedEmote fitted;
+        fit_emote(job, fitted);
+        lock.lock();
+        g_emote_fitted.push_back(std::move(fitted));
+    }
+}
+
+// Register (or replace) the image chat words equal to `name` are drawn
+// with: tightly packed RGBA8, copied before returning. False when the image
+// is unusable or too many registrations are still waiting.
+extern "C" bool vr_emote_register(const char* name, const uint8_t* rgba,
+                                  uint32_t width, uint32_t height) {
+    if (!name || !*name || strchr(name, ' ') || !rgba) return false;
+    if (width == 0 || height == 0 || width > EMOTE_MAX_SOURCE_SIZE || height > EMOTE_MAX_SOURCE_SIZE) {
+        return false;
+    }
+
+    EmoteJob job;
+    job.name = name;
+    job.rgba.assign(rgba, rgba + (size_t)width * height * 4);
+    job.width = width;
+    job.height = height;
+
+    std::lock_guard<std::mutex> lock(g_emote_mutex);
+    if (g_emote_jobs.size() >= EMOTE_QUEUE_MAX) return false;
+    if (!g_emote_worker_running) {
+        g_emote_worker_running = true;     // Started on first use; joined in release_emote_atlas
+        g_emote_worker = std::thread(emote_worker_main);
+    }
+    g_emote_jobs.push_back(std::move(job));
+    g_emote_cv.notify_one();
+    return true;
+}
+
+static Emote* find_emote(const char* word, size_t len) {
+    if (g_emotes.empty() || len == 0) return nullptr;
+    g_emote_lookup.assign(word, len);
+    auto it = g_emotes.find(g_emote_lookup);
+    return it != g_emotes.end() ? &it->second : nullptr;
+}
+
+static bool is_blank(char c) {
+    return c == ' ' || c == '\t';
+}
+
+static bool text_has_emotes(const char* s, const char* end) {
+    if (g_emotes.empty()) return false;
+    while (s < end) {
+        while (s < end && (is_blank(*s) || *s == '\n')) s++;
+        const char* word = s;
+        while (s < end && !is_blank(*s) && *s != '\n') s++;
+        if (find_emote(word, s - word)) return true;
+    }
+    return false;
+}
+
+// Drawn size of an emote on a line of `font_size`
+static float emote_width(const Emote& e, float font_size) {
+    return font_size * fminf((float)e.width / (float)e.height, EMOTE_MAX_ASPECT);
 }
 
-// Default test with main overlay
-extern "C" LaserHit vr_test_laser_intersection_main(int controller_idx) {
-    return vr_test_laser_intersection(controller_idx, g_handle);
+// Free cell, or the least recently drawn one the last chat list didn't show
+static int take_emote_cell() {
+    int lru = -1;
+    for (int i = 0; i < EMOTE_CELL_COUNT; i++) {
+        Emote* owner = g_emote_cells[i];
+        if (!owner) return i;
+        if (owner->last_drawn >= g_emote_build) continue;
+        if (lru < 0 || owner->last_drawn < g_emote_cells[lru]->last_drawn) lru = i;
+    }
+    if (lru >= 0) {
+        g_emote_cells[lru]->cell = -1;
+        g_emote_cells[lru] = nullptr;
+    }
+    return lru;
 }
 
-extern "C" void vr_trigger_haptic_pulse(int controller_idx, unsigned short duration_us) {
-    if (controller_idx < 0 || controller_idx > 1) return;
-    if (!g_controllers[controller_idx].connected) return;
+// Render side, before each HUD render: take in fitted emotes and upload
+// the cells drawn as placeholders since the last call
+static void update_emote_atlas() {
+    {
+        std::lock_guard<std::mutex> lock(g_emote_mutex);
+        std::swap(g_emote_fitted, g_emote_fitted_drain);
+    }
+    if (!g_emote_fitted_drain.empty()) {
+        for (FittedEmote& f : g_emote_fitted_drain) {
+            auto it = g_emotes.find(f.name);
+            if (it == g_emotes.end()) {
+                if (g_emotes.size() >= EMOTE_MAX_KNOWN) continue;
+                it = g_emotes.emplace(std::move(f.name), Emote()).first;
+            }
+            Emote& e = it->second;
+            e.pixels = std::move(f.pixels);
+            e.width = f.width;
+            e.height = f.height;
+            if (e.cell >= 0) {
+                g_emote_cells[e.cell] = nullptr;   // Re-uploaded when next drawn
+                e.cell = -1;
+            }
+        }
+        g_emote_fitted_drain.clear();
+        // Words that just became emotes re-wrap
+        g_chat_lines_wrap_width = -1.0f;
+        mark_dirty(g_hud_retained);
+    }
 
-    g_vrs->TriggerHapticPulse(g_controllers[controller_idx].device_index, 0, duration_us);
+    if (g_emote_wanted.empty()) return;
+    if (!g_emote_atlas) {
+        g_emote_atlas = backend_create_texture(EMOTE_ATLAS_SIZE, EMOTE_ATLAS_SIZE);
+        if (!g_emote_atlas) return;    // Placeholders until the backend manages
+    }
+
+    size_t done = 0;
+    int uploads = 0;
+    for (; done < g_emote_wanted.size() && uploads < EMOTE_UPLOADS_PER_FRAME; done++) {
+        Emote* e = g_emote_wanted[done];
+        if (e->cell >= 0) {
+            e->wanted = false;
+            continue;
+        }
+        int cell = take_emote_cell();
+        if (cell < 0) break;    // Every cell is on screen
+        uint32_t x = (cell % EMOTE_CELLS_PER_ROW) * EMOTE_CELL_SIZE;
+        uint32_t y = (cell / EMOTE_CELLS_PER_ROW) * EMOTE_CELL_SIZE;
+        if (!backend_update_texture(g_emote_atlas, x, y, EMOTE_CELL_SIZE, EMOTE_CELL_SIZE,
+                                    e->pixels.data())) {
+            break;              // Out of staging memory this frame
+        }
+        e->cell = cell;
+        e->wanted = false;
+        g_emote_cells[cell] = e;
+        uploads++;
+    }
+    g_emote_wanted.erase(g_emote_wanted.begin(), g_emote_wanted.begin() + done);
+
+    if (uploads > 0) {
+        // A refilled cell changes pixels under unchanged geometry, which
+        // the draw-list diff can't see
+        g_hud_damage.valid = false;
+        mark_dirty(g_hud_retained);
+    }
 }
 
-extern "C" uint32_t vr_find_hip_tracker() {
-    for (uint32_t i = 0; i < k_unMaxTrackedDeviceCount; i++) {
-        if (g_vrs->GetTrackedDeviceClass(i) == TrackedDeviceClass_GenericTracker) {
-            TrackedDevicePose_t pose;
-            g_vrc->GetLastPoses(&pose, 1, nullptr, 0);
-
-            if (pose.bPoseIsValid) {
-                float y = pose.mDeviceToAbsoluteTracking.m[1][3];
-                // Hip trackers are typically 0.8-1.2m high
-                if (y > 0.8f && y < 1.2f) {
-                    return i;
-                }
+static void release_emote_atlas() {
+    {
+        std::lock_guard<std::mutex> lock(g_emote_mutex);
+        g_emote_worker_running = false;
+        g_emote_jobs.clear();
+        g_emote_fitted.clear();
+    }
+    g_emote_cv.notify_all();
+    if (g_emote_worker.joinable()) g_emote_worker.join();
+
+    backend_destroy_texture(g_emote_atlas);
+    g_emote_atlas = nullptr;
+    g_emotes.clear();
+    g_emote_wanted.clear();
+    for (Emote*& owner : g_emote_cells) owner = nullptr;
+}
+
+// Draw one laid-out line of a message with emotes at the cursor: text runs
+// between emote words go out as single AddText calls
+static void draw_emote_line(const char* s, const char* end) {
+    ImDrawList* draw_list = ImGui::GetWindowDrawList();
+    ImFont* font = ImGui::GetFont();
+    const float font_size = ImGui::GetFontSize();
+    const ImU32 text_color = ImGui::GetColorU32(ImGuiCol_Text);
+    const ImVec2 origin = ImGui::GetCursorScreenPos();
+    float x = origin.x;
+
+    const char* run = s;
+    while (s < end) {
+        const char* word = s;
+        while (s < end && !is_blank(*s)) s++;
+        Emote* e = find_emote(word, s - word);
+        if (!e) {
+            while (s < end && is_blank(*s)) s++;
+            continue;
+        }
+
+        if (run < word) {
+            draw_list->AddText(font, font_size, ImVec2(x, origin.y), text_color, run, word);
+            x += font->CalcTextSizeA(font_size, FLT_MAX, 0.0f, run, word).x;
+        }
+        float w = emote_width(*e, font_size);
+        ImVec2 p0(x, origin.y), p1(x + w, origin.y + font_size);
+        if (e->cell >= 0) {
+            const float texel = 1.0f / (float)EMOTE_ATLAS_SIZE;
+            float u0 = ((e->cell % EMOTE_CELLS_PER_ROW) * EMOTE_CELL_SIZE + EMOTE_CELL_PADDING) * texel;
+            float v0 = ((e->cell / EMOTE_CELLS_PER_ROW) * EMOTE_CELL_SIZE + EMOTE_CELL_PADDING) * texel;
+            // Wide emotes past EMOTE_MAX_ASPECT are squeezed rather than cropped
+            draw_list->AddImage(backend_texture_id(g_emote_atlas), p0, p1, ImVec2(u0, v0),
+                                ImVec2(u0 + e->width * texel, v0 + e->height * texel));
+        } else {
+            draw_list->AddRectFilled(p0, p1, IM_COL32(255, 255, 255, 24), 3.0f);
+            if (!e->wanted) {
+                e->wanted = true;
+                g_emote_wanted.push_back(e);
             }
         }
+        e->last_drawn = g_emote_build;
+        x += w;
+        run = s;
+        while (s < end && is_blank(*s)) s++;
+    }
+    if (run < end) {
+        draw_list->AddText(font, font_size, ImVec2(x, origin.y), text_color, run, end);
+        x += font->CalcTextSizeA(font_size, FLT_MAX, 0.0f, run, end).x;
     }
-    return k_unTrackedDeviceIndexInvalid;
+    ImGui::Dummy(ImVec2(x - origin.x, ImGui::GetTextLineHeight()));
 }
 
-// ─────────────────────────── ImGui Functions ───────────────────────────
-extern "C" void imgui_init(void* device_ptr, void* context_ptr) {
-    g_device = (ID3D11Device*)device_ptr;
-    g_context = (ID3D11DeviceContext*)context_ptr;
+// ─────────────────────────── Font Atlas Cache ──────────────────────────
+// Rasterizing the font atlas is most of imgui_init's CPU time, so the built
+// atlas (Alpha8 pixels, UVs and the glyph table) is written to a cache file
+// whose name hashes everything the build depends on. A later launch reads
+// it straight into the atlas: the backend then uploads it on its first
+// frame without ImGui ever building it. A missing, stale or damaged file
+// just falls back to building. Set the directory before imgui_init.
+static const float UI_SCALE = 1.5f;   // Style sizes and FontGlobalScale, for VR readability
+static const char FONT_CACHE_MAGIC[8] = { 'M', 'B', 'F', 'O', 'N', 'T', '1', 0 };
+
+struct FontCacheHeader {
+    char magic[8];
+    uint64_t key;
+    int32_t tex_width;
+    int32_t tex_height;
+    float font_size;
+    float ascent;
+    float descent;
+    uint32_t fallback_char;
+    uint32_t ellipsis_char;
+    uint32_t glyph_count;
+    ImVec2 uv_scale;
+    ImVec2 uv_white_pixel;
+    ImVec4 uv_lines[sizeof(ImFontAtlas::TexUvLines) / sizeof(ImVec4)];
+};
 
-    // Create render targets
-    const int width = 1024;
-    const int height = 768;
+static std::string g_font_cache_dir;   // Empty = no cache
 
-    D3D11_TEXTURE2D_DESC desc = {};
-    desc.Width = width;
-    desc.Height = height;
-    desc.MipLevels = 1;
-    desc.ArraySize = 1;
-    desc.Format = DXGI_FORMAT_B8G8R8A8_UNORM;
-    desc.SampleDesc.Count = 1;
-    desc.Usage = D3D11_USAGE_DEFAULT;
-    desc.BindFlags = D3D11_BIND_RENDER_TARGET | D3D11_BIND_SHADER_RESOURCE;
-    desc.MiscFlags = D3D11_RESOURCE_MISC_SHARED;
+extern "C" void imgui_set_font_cache_dir(const char* dir) {
+    g_font_cache_dir = dir ? dir : "";
+}
 
-    for (int i = 0; i < 2; i++) {
-        g_device->CreateTexture2D(&desc, nullptr, &g_textures[i]);
-        g_device->CreateRenderTargetView(g_textures[i], nullptr, &g_rtvs[i]);
-        g_device->CreateShaderResourceView(g_textures[i], nullptr, &g_srvs[i]);
+// What the atlas is built from: the default font's config is fixed by the
+// ImGui version. Includes the binary layout the glyph table is dumped in.
+static uint64_t font_cache_key(const ImFontAtlas* atlas) {
+    char desc[256];
+    snprintf(desc, sizeof(desc), "%s|%d|ProggyClean|%d|%d|%.2f|%d|%d",
+             IMGUI_VERSION, IMGUI_VERSION_NUM, atlas->TexDesiredWidth, atlas->TexGlyphPadding,
+             UI_SCALE, (int)sizeof(ImFontGlyph), (int)sizeof(FontCacheHeader));
+    uint64_t hash = 1469598103934665603ull;   // FNV-1a
+    for (const char* c = desc; *c; c++) hash = (hash ^ (uint8_t)*c) * 1099511628211ull;
+    return hash;
+}
+
+static std::string font_cache_file(uint64_t key) {
+    char name[64];
+    snprintf(name, sizeof(name), "/imgui-font-%016llx.bin", (unsigned long long)key);
+    return g_font_cache_dir + name;
+}
+
+static bool load_font_atlas(ImFontAtlas* atlas, uint64_t key) {
+    FILE* f = fopen(font_cache_file(key).c_str(), "rb");
+    if (!f) return false;
+
+    FontCacheHeader h;
+    bool ok = fread(&h, sizeof(h), 1, f) == 1 && memcmp(h.magic, FONT_CACHE_MAGIC, sizeof(h.magic)) == 0 &&
+              h.key == key && h.tex_width > 0 && h.tex_width <= 8192 && h.tex_height > 0 &&
+              h.tex_height <= 8192 && h.glyph_count > 0 && h.glyph_count <= 0x10000;
+    unsigned char* pixels = nullptr;
+    ImVector<ImFontGlyph> glyphs;
+    if (ok) {
+        size_t pixel_bytes = (size_t)h.tex_width * h.tex_height;
+        pixels = (unsigned char*)IM_ALLOC(pixel_bytes);
+        glyphs.resize((int)h.glyph_count);
+        ok = fread(pixels, 1, pixel_bytes, f) == pixel_bytes &&
+             fread(glyphs.Data, sizeof(ImFontGlyph), h.glyph_count, f) == h.glyph_count;
     }
-    
-    // Create dashboard render targets (larger size for settings UI)
-    desc.Width = 1280;
-    desc.Height = 960;
-    for (int i = 0; i < 2; i++) {
-        g_device->CreateTexture2D(&desc, nullptr, &g_dashboard_textures[i]);
-        g_device->CreateRenderTargetView(g_dashboard_textures[i], nullptr, &g_dashboard_rtvs[i]);
-        g_device->CreateShaderResourceView(g_dashboard_textures[i], nullptr, &g_dashboard_srvs[i]);
+    fclose(f);
+    if (!ok) {
+        if (pixels) IM_FREE(pixels);
+        return false;
     }
 
-    // Initialize ImGui
-    IMGUI_CHECKVERSION();
-    g_imgui_ctx = ImGui::CreateContext();
-    ImGui::SetCurrentContext(g_imgui_ctx);
+    ImFontConfig cfg;
+    cfg.FontDataOwnedByAtlas = false;
+    cfg.SizePixels = h.font_size;
+    snprintf(cfg.Name, sizeof(cfg.Name), "ProggyClean.ttf, %dpx (cached)", (int)h.font_size);
+    atlas->ConfigData.push_back(cfg);
+
+    ImFont* font = IM_NEW(ImFont);
+    atlas->Fonts.push_back(font);
+    font->ContainerAtlas = atlas;
+    font->ConfigData = &atlas->ConfigData[0];
+    font->ConfigDataCount = 1;
+    font->FontSize = h.font_size;
+    font->Ascent = h.ascent;
+    font->Descent = h.descent;
+    font->FallbackChar = (ImWchar)h.fallback_char;
+    font->EllipsisChar = (ImWchar)h.ellipsis_char;
+    font->Glyphs.resize(glyphs.Size);
+    memcpy(font->Glyphs.Data, glyphs.Data, (size_t)glyphs.Size * sizeof(ImFontGlyph));
+    font->BuildLookupTable();
+
+    atlas->TexPixelsAlpha8 = pixels;    // Freed by the atlas like a built one
+    atlas->TexWidth = h.tex_width;
+    atlas->TexHeight = h.tex_height;
+    atlas->TexUvScale = h.uv_scale;
+    atlas->TexUvWhitePixel = h.uv_white_pixel;
+    memcpy(atlas->TexUvLines, h.uv_lines, sizeof(h.uv_lines));
+    atlas->TexReady = true;
+    return true;
+}
+
+// Written beside the final name and renamed over it, so a concurrent
+// launch never reads half a file
+static void save_font_atlas(ImFontAtlas* atlas, uint64_t key) {
+    unsigned char* pixels = nullptr;
+    int width = 0, height = 0;
+    atlas->GetTexDataAsAlpha8(&pixels, &width, &height);
+    if (!pixels || atlas->Fonts.Size != 1) return;
+    const ImFont* font = atlas->Fonts[0];
+
+    FontCacheHeader h = {};
+    memcpy(h.magic, FONT_CACHE_MAGIC, sizeof(h.magic));
+    h.key = key;
+    h.tex_width = width;
+    h.tex_height = height;
+    h.font_size = font->FontSize;
+    h.ascent = font->Ascent;
+    h.descent = font->Descent;
+    h.fallback_char = font->FallbackChar;
+    h.ellipsis_char = font->EllipsisChar;
+    h.glyph_count = (uint32_t)font->Glyphs.Size;
+    h.uv_scale = atlas->TexUvScale;
+    h.uv_white_pixel = atlas->TexUvWhitePixel;
+    memcpy(h.uv_lines, atlas->TexUvLines, sizeof(h.uv_lines));
+
+    std::string path = font_cache_file(key);
+    std::string temp = path + ".tmp";
+    FILE* f = fopen(temp.c_str(), "wb");
+    if (!f) return;
+    bool ok = fwrite(&h, sizeof(h), 1, f) == 1 &&
+              fwrite(pixels, 1, (size_t)width * height, f) == (size_t)width * height &&
+              fwrite(font->Glyphs.Data, sizeof(ImFontGlyph), h.glyph_count, f) == h.glyph_count;
+    ok = fclose(f) == 0 && ok;
+    if (ok) {
+        remove(path.c_str());   // rename doesn't replace on Windows
+        ok = rename(temp.c_str(), path.c_str()) == 0;
+    }
+    if (!ok) remove(temp.c_str());
+}
 
+// The default font, from the cache when there is a usable one
+static void setup_font_atlas() {
+    ImFontAtlas* atlas = ImGui::GetIO().Fonts;
+    if (g_font_cache_dir.empty()) return;   // The backend builds it as usual
+    uint64_t key = font_cache_key(atlas);
+    if (load_font_atlas(atlas, key)) return;
+
+    atlas->AddFontDefault();
+    save_font_atlas(atlas, key);
+}
+
+// ─────────────────────────── ImGui Functions ───────────────────────────
+// Context setup shared by imgui_init and the headless benchmark
+static void configure_imgui_context(int width, int height) {
     ImGuiIO& io = ImGui::GetIO();
     io.DisplaySize = ImVec2((float)width, (float)height);
     io.ConfigFlags |= ImGuiConfigFlags_NavEnableKeyboard;
@@ -664,67 +3263,278 @@ extern "C" void imgui_init(void* device_ptr, void* context_ptr) {
     style.WindowBorderSize = 0.0f;
 
     // Scale for VR readability
-    style.ScaleAllSizes(1.5f);
-    io.FontGlobalScale = 1.5f;
+    style.ScaleAllSizes(UI_SCALE);
+    io.FontGlobalScale = UI_SCALE;
+
+    setup_font_atlas();
+}
+
+// False when the render backend couldn't be set up; ImGui is torn down again
+extern "C" bool imgui_init(void* device_ptr, void* context_ptr) {
+
+    // Render targets come from the pool, created and sized on each overlay's
+    // first render rather than here
+    const int width = 1024;
+    const int height = 768;
+
+    // Initialize ImGui
+    install_imgui_heap();
+    IMGUI_CHECKVERSION();
+    g_imgui_ctx = ImGui::CreateContext();
+    ImGui::SetCurrentContext(g_imgui_ctx);
+
+    configure_imgui_context(width, height);
 
-    ImGui_ImplDX11_Init(g_device, g_context);
+    if (!backend_init(device_ptr, context_ptr)) {
+        backend_shutdown();
+        ImGui::DestroyContext(g_imgui_ctx);
+        g_imgui_ctx = nullptr;
+        return false;
+    }
+    return true;
 }
 
 extern "C" void imgui_shutdown() {
-    ImGui_ImplDX11_Shutdown();
+    if (g_keyboard_draw_list) {
+        IM_DELETE(g_keyboard_draw_list);
+        g_keyboard_draw_list = nullptr;
+    }
+    release_registry_render_state();
+    release_emote_atlas();
+    g_imgui_frame_ready = false;
+    backend_imgui_shutdown();
     ImGui::DestroyContext(g_imgui_ctx);
 
-    for (int i = 0; i < 2; i++) {
-        if (g_rtvs[i]) g_rtvs[i]->Release();
-        if (g_srvs[i]) g_srvs[i]->Release();
-        if (g_textures[i]) g_textures[i]->Release();
-        
-        if (g_dashboard_rtvs[i]) g_dashboard_rtvs[i]->Release();
-        if (g_dashboard_srvs[i]) g_dashboard_srvs[i]->Release();
-        if (g_dashboard_textures[i]) g_dashboard_textures[i]->Release();
-    }
+    destroy_render_target_pool();
+    destroy_gpu_timers();
+    backend_shutdown();
 }
 
+// Pointer and laser setters only stage values; see imgui_publish_input
 extern "C" void imgui_inject_mouse_pos(float x, float y) {
-    g_mouse_x = x;
-    g_mouse_y = y;
+    g_input_staging.mouse_x = x;
+    g_input_staging.mouse_y = y;
 }
 
 extern "C" void imgui_inject_mouse_button(int button, bool down) {
     if (button == 0) {
-        g_mouse_down = down;
+        g_input_staging.mouse_down = down;
     }
 }
 
+extern "C" void imgui_set_retained_mode(bool enabled) {
+    g_retained_mode = enabled;
+    mark_dirty(g_hud_retained);
+    mark_dirty(g_dashboard_retained);
+    mark_dirty(g_keyboard_retained);
+}
+
+// Force every overlay to re-render on its next render call
+extern "C" void imgui_mark_dirty() {
+    mark_dirty(g_hud_retained);
+    mark_dirty(g_dashboard_retained);
+    mark_dirty(g_keyboard_retained);
+}
+
 extern "C" bool imgui_get_input_focused() {
-    bool result = g_input_just_focused;
-    g_input_just_focused = false; // Clear the flag after reading
-    return result;
+    return g_input_just_focused.exchange(false);  // Clear the flag after reading
+}
+
+static void chat_evict_oldest_chunk() {
+    uint64_t serial = g_chat_chunks.front().serial;
+    while (!g_chat_entries.empty() && g_chat_entries.front().chunk_serial == serial) {
+        if (g_chat_laid_out > 0) {
+            size_t n = g_chat_entries.front().line_count;
+            g_chat_lines.erase(g_chat_lines.begin(), g_chat_lines.begin() + n);
+            g_chat_evicted_lines += n;
+            g_chat_laid_out--;
+        }
+        ChatAuthorTable::value_type* author = g_chat_entries.front().author_ref;
+        if (--author->second == 0) {
+            g_chat_authors.erase(g_chat_authors.find(author->first));
+        }
+        g_chat_entries.pop_front();
+    }
+    g_chat_arena_bytes -= g_chat_chunks.front().data.size();
+    g_chat_chunks.pop_front();
+}
+
+static char* chat_arena_alloc(size_t bytes, uint64_t* serial) {
+    if (g_chat_chunks.empty() ||
+        g_chat_chunks.back().used + bytes > g_chat_chunks.back().data.size()) {
+        size_t capacity = bytes > CHAT_CHUNK_SIZE ? bytes : CHAT_CHUNK_SIZE;
+        while (!g_chat_chunks.empty() && g_chat_arena_bytes + capacity > g_chat_max_bytes) {
+            chat_evict_oldest_chunk();
+        }
+        g_chat_chunks.push_back({std::vector<char>(capacity), 0, g_chat_next_chunk_serial++});
+        g_chat_arena_bytes += capacity;
+    }
+
+    ChatChunk& chunk = g_chat_chunks.back();
+    char* out = chunk.data.data() + chunk.used;
+    chunk.used += bytes;
+    *serial = chunk.serial;
+    return out;
+}
+
+static void chat_store(uint64_t id, const char* author, size_t author_len,
+                       const char* text, size_t text_len) {
+    // Element pointers stay valid across rehashing, so entries can hold them
+    ChatAuthorTable::value_type& author_ref =
+        *g_chat_authors.emplace(std::string(author, author_len), 0).first;
+    author_ref.second++;
+
+    uint64_t serial;
+    char* text_dst = chat_arena_alloc(text_len + 1, &serial);
+    memcpy(text_dst, text, text_len);
+    text_dst[text_len] = 0;
+
+    g_chat_entries.push_back({id, serial, &author_ref, author_ref.first.c_str(), text_dst,
+                              (uint32_t)author_len, (uint32_t)text_len, 0, 0.0f, false});
+}
+
+// Caller holds g_chat_inbox_mutex
+static void chat_post(const char* author, size_t author_len, const char* text, size_t text_len) {
+    ChatInbox& inbox = g_chat_inbox;
+    ChatRecordFFI r;
+    r.author_offset = (uint32_t)inbox.bytes.size();
+    r.author_len = (uint32_t)author_len;
+    inbox.bytes.insert(inbox.bytes.end(), author, author + author_len);
+    r.text_offset = (uint32_t)inbox.bytes.size();
+    r.text_len = (uint32_t)text_len;
+    inbox.bytes.insert(inbox.bytes.end(), text, text + text_len);
+    inbox.records.push_back(r);
+}
+
+// Caller holds g_chat_inbox_mutex
+static void chat_post_clear() {
+    g_chat_inbox.bytes.clear();
+    g_chat_inbox.records.clear();
+    g_chat_inbox.clear = true;
+}
+
+// Caller holds g_chat_inbox_mutex. Records that point outside the arena are
+// kept as empty messages so ids stay in step with the sender's sequence numbers.
+static uint64_t chat_post_packed(const uint8_t* bytes, size_t bytes_len,
+                                 const ChatRecordFFI* records, size_t records_count) {
+    if (!records || records_count == 0) return g_chat_posted_seq;
+
+    const char* arena = (const char*)bytes;
+    for (size_t i = 0; i < records_count; i++) {
+        ChatRecordFFI r = records[i];
+        if (!arena || (size_t)r.author_offset + r.author_len > bytes_len) r.author_len = 0;
+        if (!arena || (size_t)r.text_offset + r.text_len > bytes_len) r.text_len = 0;
+
+        chat_post(r.author_len ? arena + r.author_offset : "", r.author_len,
+                  r.text_len ? arena + r.text_offset : "", r.text_len);
+    }
+
+    g_chat_posted_seq += records_count;
+    return g_chat_posted_seq;
+}
+
+extern "C" uint64_t imgui_chat_append_packed(const uint8_t* bytes, size_t bytes_len,
+                                             const ChatRecordFFI* records, size_t records_count) {
+    std::lock_guard<std::mutex> lock(g_chat_inbox_mutex);
+    return chat_post_packed(bytes, bytes_len, records, records_count);
+}
+
+extern "C" void imgui_chat_clear() {
+    std::lock_guard<std::mutex> lock(g_chat_inbox_mutex);
+    chat_post_clear();
 }
 
-extern "C" void imgui_update_chat_state(const uint8_t* messages_ptr, size_t messages_count,
-                                       uint8_t* input_buffer, size_t input_capacity) {
-    // Update messages
-    g_chat_messages.clear();
-    if (messages_ptr && messages_count > 0) {
-        const ChatMessage* msgs = (const ChatMessage*)messages_ptr;
-        for (size_t i = 0; i < messages_count; i++) {
-            g_chat_messages.push_back(msgs[i]);
+extern "C" uint64_t imgui_chat_sequence() {
+    std::lock_guard<std::mutex> lock(g_chat_inbox_mutex);
+    return g_chat_posted_seq;
+}
+
+// Memory budget for the scrollback arena; the oldest messages are dropped
+// whenever it is exceeded. Never goes below one chunk.
+extern "C" void imgui_chat_set_history_budget(size_t bytes) {
+    std::lock_guard<std::mutex> lock(g_chat_inbox_mutex);
+    g_chat_inbox.history_budget = bytes > CHAT_CHUNK_SIZE ? bytes : CHAT_CHUNK_SIZE;
+}
+
+// Move everything posted since the last frame into the scrollback. The
+// inbox is swapped out under the lock and applied outside it; both buffers
+// keep their capacity, so steady-state posting doesn't allocate.
+static void drain_chat_inbox() {
+    {
+        std::lock_guard<std::mutex> lock(g_chat_inbox_mutex);
+        if (!g_chat_inbox.clear && g_chat_inbox.history_budget == 0 && g_chat_inbox.records.empty()) {
+            return;
+        }
+        std::swap(g_chat_inbox, g_chat_inbox_drain);
+    }
+
+    ChatInbox& in = g_chat_inbox_drain;
+    if (in.clear) {
+        g_chat_entries.clear();
+        g_chat_authors.clear();
+        g_chat_chunks.clear();
+        g_chat_arena_bytes = 0;
+        g_chat_lines.clear();
+        g_chat_laid_out = 0;
+        g_chat_evicted_lines = 0;
+    }
+    if (in.history_budget) {
+        g_chat_max_bytes = in.history_budget;
+        while (!g_chat_chunks.empty() && g_chat_arena_bytes > g_chat_max_bytes) {
+            chat_evict_oldest_chunk();
         }
     }
+
+    const char* arena = in.bytes.data();
+    for (size_t i = 0; i < in.records.size(); i++) {
+        const ChatRecordFFI& r = in.records[i];
+        chat_store(g_chat_seq + i + 1, arena + r.author_offset, r.author_len,
+                   arena + r.text_offset, r.text_len);
+    }
+    g_chat_seq += in.records.size();
+
+    in.bytes.clear();
+    in.records.clear();
+    in.clear = false;
+    in.history_budget = 0;
+    mark_dirty(g_hud_retained);
 }
 
 extern "C" bool imgui_get_sent_message(uint8_t* buffer, size_t capacity) {
+    std::lock_guard<std::mutex> lock(g_outbox_mutex);
     if (g_message_sent && buffer && capacity > 0) {
-        strncpy((char*)buffer, g_input_buffer, capacity - 1);
+        strncpy((char*)buffer, g_sent_message, capacity - 1);
         buffer[capacity - 1] = 0;
         g_message_sent = false;
-        g_input_buffer[0] = 0;
         return true;
     }
     return false;
 }
 
+static void render_frame_stats() {
+    static const char* stage_names[STAGE_COUNT] = {
+        "Frame", "Wait", "Controllers", "UI build", "Draw (CPU)", "Submit", "GPU"
+    };
+
+    FrameStats stats;
+    vr_get_frame_stats(&stats);
+
+    ImGui::Text("Frame Timing");
+    ImGui::Separator();
+    ImGui::Text("%-12s %8s %8s %8s %8s", "Stage", "last", "p50", "p99", "max");
+    for (int i = 0; i < STAGE_COUNT; i++) {
+        const FrameStageStats& st = stats.stages[i];
+        ImGui::Text("%-12s %8.2f %8.2f %8.2f %8.2f", stage_names[i],
+                    st.last_ms, st.p50_ms, st.p99_ms, st.max_ms);
+    }
+    ImGui::Spacing();
+    ImGui::TextDisabled("Milliseconds over the last %d samples of each stage", FRAME_STATS_HISTORY);
+    ImGui::Spacing();
+    ImGui::Text("Last UI build: %u ImGui allocations, %u from the system heap",
+                stats.ui_allocations, stats.ui_heap_allocations);
+    ImGui::Text("System heap allocations since start: %llu", (unsigned long long)stats.heap_allocations);
+}
+
 static void render_settings_window() {
     // For dashboard mode, we want to use the full canvas instead of a window
     ImGuiIO& io = ImGui::GetIO();
@@ -754,7 +3564,8 @@ static void render_settings_window() {
         
         // Show current tab title
         const char* tab_names[] = {"Connection", "General", "Platforms", "Customize UI", 
-                                  "Audio", "Stream Overlay", "Quick Actions", "Plugins", "About"};
+                                  "Audio", "Stream Overlay", "Quick Actions", "Plugins", "About",
+                                  "Performance"};
         ImGui::Text("%s", tab_names[current_tab]);
         ImGui::Separator();
         ImGui::Spacing();
@@ -777,7 +3588,8 @@ static void render_settings_window() {
             "📺 Stream Overlay",
             "⚡ Quick Actions",
             "🧩 Plugins",
-            "ℹ️ About"
+            "ℹ️ About",
+            "📊 Performance"
         };
         
         for (int i = 0; i < IM_ARRAYSIZE(tabs); i++) {
@@ -785,7 +3597,7 @@ static void render_settings_window() {
                 current_tab = i;
                 show_tabs = false;  // Hide tabs and show content
                 g_dashboard_state.current_tab = i;
-                g_dashboard_state_changed = true;
+                post_dashboard_state();
             }
         }
         
@@ -857,18 +3669,23 @@ static void render_settings_window() {
                 ImGui::Spacing();
                 
                 // Alert settings
-                ImGui::Checkbox("Show Alerts", &g_overlay_settings.show_alerts);
+                if (ImGui::Checkbox("Show Alerts", &g_overlay_settings.show_alerts)) {
+                    publish_alert_settings();
+                }
                 
                 if (g_overlay_settings.show_alerts) {
                     ImGui::Indent();
                     ImGui::Text("Duration:");
-                    ImGui::SliderFloat("##AlertDuration", &g_overlay_settings.alert_duration, 1.0f, 30.0f, "%.1f s");
+                    if (ImGui::SliderFloat("##AlertDuration", &g_overlay_settings.alert_duration,
+                                           1.0f, 30.0f, "%.1f s")) {
+                        publish_alert_settings();
+                    }
                     ImGui::Unindent();
                 }
                 
                 ImGui::Spacing();
                 if (ImGui::Button("Apply Settings", ImVec2(150, 40))) {
-                    g_dashboard_state_changed = true;
+                    post_dashboard_state();
                 }
                 break;
                 
@@ -892,6 +3709,11 @@ static void render_settings_window() {
                 ImGui::Spacing();
                 ImGui::Text("A multi-platform streaming bot with VRChat integration");
                 break;
+
+            case 9: // Performance
+                render_frame_stats();
+                mark_dirty(g_dashboard_retained);  // Keep the numbers moving while open
+                break;
         }
         
         ImGui::EndChild();
@@ -900,9 +3722,117 @@ static void render_settings_window() {
     ImGui::End();
 }
 
+static int utf8_char_len(unsigned char c) {
+    if (c < 0x80) return 1;
+    if ((c >> 5) == 0x6) return 2;
+    if ((c >> 4) == 0xE) return 3;
+    if ((c >> 3) == 0x1E) return 4;
+    return 1;
+}
+
+// Wrap at blanks only, emote words counting their drawn width. A first word
+// too wide for the line breaks like ImGui would: text by character, an
+// emote whole.
+static const char* emote_wrap_position(const char* s, const char* end, float avail, float font_size) {
+    ImFont* font = ImGui::GetFont();
+    float x = 0.0f;
+    const char* line_begin = s;
+    while (s < end) {
+        const char* word = s;
+        while (s < end && !is_blank(*s)) s++;
+        Emote* e = find_emote(word, s - word);
+        float w = e ? emote_width(*e, font_size) : font->CalcTextSizeA(font_size, FLT_MAX, 0.0f, word, s).x;
+        if (x + w > avail) {
+            if (word > line_begin) return word;
+            if (e) return s;
+            float scale = font_size / font->FontSize;
+            return avail > 0.0f ? font->CalcWordWrapPositionA(scale, word, s, avail) : word;
+        }
+        x += w;
+        const char* blank = s;
+        while (s < end && is_blank(*s)) s++;
+        x += font->CalcTextSizeA(font_size, FLT_MAX, 0.0f, blank, s).x;
+    }
+    return end;
+}
+
+// Wrap a message the same way "author:" + SameLine + TextWrapped did: every
+// line wraps in the space right of the author label and later lines hang
+// under the first.
+static void layout_chat_entry(ChatEntry& entry, float wrap_width, float font_size) {
+    ImFont* font = ImGui::GetFont();
+    float scale = font_size / font->FontSize;
+
+    entry.author_width = ImGui::CalcTextSize(entry.author, entry.author + entry.author_len).x +
+                         ImGui::CalcTextSize(":").x + ImGui::GetStyle().ItemSpacing.x;
+    entry.line_count = 0;
+
+    const char* text = entry.text;
+    const char* text_end = text + entry.text_len;
+    const char* s = text;
+    const float avail = wrap_width - entry.author_width;
+    entry.has_emotes = text_has_emotes(text, text_end);
+
+    do {
+        const char* newline = (const char*)memchr(s, '\n', text_end - s);
+        const char* segment_end = newline ? newline : text_end;
+
+        const char* brk;
+        if (entry.has_emotes) {
+            brk = emote_wrap_position(s, segment_end, avail, font_size);
+        } else {
+            brk = avail > 0.0f ? font->CalcWordWrapPositionA(scale, s, segment_end, avail) : s;
+        }
+        if (brk == s && s < segment_end) {
+            // Too narrow to fit a word: force one character, like ImGui does
+            brk = s + utf8_char_len((unsigned char)*s);
+            if (brk > segment_end) brk = segment_end;
+        }
+
+        g_chat_lines.push_back({entry.id, (uint32_t)(s - text), (uint32_t)(brk - text)});
+        entry.line_count++;
+
+        // Skip the blanks (or the newline) that end the line
+        s = brk;
+        if (s == newline) {
+            s++;
+        } else {
+            while (s < text_end && (*s == ' ' || *s == '\t')) s++;
+        }
+    } while (s < text_end);
+}
+
+// Lay out messages appended since the last frame; re-wrap the whole history
+// only when the wrap width or font size changed.
+static void update_chat_lines(float wrap_width, float font_size) {
+    if (wrap_width != g_chat_lines_wrap_width || font_size != g_chat_lines_font_size) {
+        g_chat_lines.clear();
+        g_chat_laid_out = 0;
+        g_chat_evicted_lines = 0;
+        g_chat_lines_wrap_width = wrap_width;
+        g_chat_lines_font_size = font_size;
+    }
+
+    for (; g_chat_laid_out < g_chat_entries.size(); g_chat_laid_out++) {
+        layout_chat_entry(g_chat_entries[g_chat_laid_out], wrap_width, font_size);
+    }
+}
+
+// The HUD target wraps the chat window as the settings place it, with the
+// same margin on the far sides. width/height are used only without a size.
+static void hud_target_size(uint32_t width, uint32_t height,
+                            uint32_t* target_width, uint32_t* target_height) {
+    const OverlaySettingsFFI& s = g_overlay_settings;
+    float w = s.chat_width > 0.0f ? 2.0f * fmaxf(s.chat_position_x, 0.0f) + s.chat_width : (float)width;
+    float h = s.chat_height > 0.0f ? 2.0f * fmaxf(s.chat_position_y, 0.0f) + s.chat_height : (float)height;
+    *target_width = (uint32_t)fminf(fmaxf(ceilf(w), 1.0f), (float)MAX_RENDER_TARGET_SIZE);
+    *target_height = (uint32_t)fminf(fmaxf(ceilf(h), 1.0f), (float)MAX_RENDER_TARGET_SIZE);
+}
+
 static void render_chat_window(bool is_dashboard) {
-    ImGui::SetNextWindowPos(ImVec2(10, 10), ImGuiCond_FirstUseEver);
-    ImGui::SetNextWindowSize(ImVec2(1004, 748), ImGuiCond_FirstUseEver);
+    const OverlaySettingsFFI& s = g_overlay_settings;
+    ImGui::SetNextWindowPos(ImVec2(fmaxf(s.chat_position_x, 0.0f), fmaxf(s.chat_position_y, 0.0f)));
+    ImGui::SetNextWindowSize(ImVec2(s.chat_width, s.chat_height));
 
     ImGui::Begin("Chat", nullptr,
         ImGuiWindowFlags_NoCollapse |
@@ -917,11 +3847,44 @@ static void render_chat_window(bool is_dashboard) {
     // Chat area
     ImVec2 chat_size = ImVec2(0, -ImGui::GetFrameHeightWithSpacing() - 10);
     if (ImGui::BeginChild("ChatArea", chat_size, true)) {
-        for (const auto& msg : g_chat_messages) {
-            ImGui::TextColored(ImVec4(0.8f, 0.8f, 0.2f, 1.0f), "%s:", msg.author);
-            ImGui::SameLine();
-            ImGui::TextWrapped("%s", msg.text);
+        update_chat_lines(ImGui::GetContentRegionAvail().x, ImGui::GetFontSize());
+
+        const float line_height = ImGui::GetTextLineHeightWithSpacing();
+
+        // Keep a scrolled-back view steady while old lines fall off the top
+        if (g_chat_evicted_lines > 0) {
+            float scroll_y = ImGui::GetScrollY();
+            if (scroll_y < ImGui::GetScrollMaxY()) {
+                scroll_y -= g_chat_evicted_lines * line_height;
+                ImGui::SetScrollY(scroll_y > 0.0f ? scroll_y : 0.0f);
+            }
+            g_chat_evicted_lines = 0;
+        }
+
+        // Only the visible wrapped lines are emitted
+        g_emote_build++;
+        const uint64_t first_id = g_chat_entries.empty() ? 0 : g_chat_entries.front().id;
+        ImGuiListClipper clipper;
+        clipper.Begin((int)g_chat_lines.size(), line_height);
+        while (clipper.Step()) {
+            for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++) {
+                const ChatVisualLine& vl = g_chat_lines[i];
+                const ChatEntry& entry = g_chat_entries[vl.message_id - first_id];
+
+                if (vl.begin == 0) {
+                    ImGui::TextColored(ImVec4(0.8f, 0.8f, 0.2f, 1.0f), "%s:", entry.author);
+                    ImGui::SameLine();
+                } else {
+                    ImGui::SetCursorPosX(ImGui::GetCursorPosX() + entry.author_width);
+                }
+                if (entry.has_emotes) {
+                    draw_emote_line(entry.text + vl.begin, entry.text + vl.end);
+                } else {
+                    ImGui::TextUnformatted(entry.text + vl.begin, entry.text + vl.end);
+                }
+            }
         }
+        clipper.End();
 
         // Auto-scroll
         if (ImGui::GetScrollY() >= ImGui::GetScrollMaxY())
@@ -942,7 +3905,8 @@ static void render_chat_window(bool is_dashboard) {
 
     if (ImGui::InputText("##Input", g_input_buffer, sizeof(g_input_buffer), input_flags)) {
         if (strlen(g_input_buffer) > 0) {
-            g_message_sent = true;
+            post_sent_message(g_input_buffer);
+            g_input_buffer[0] = 0;
             reclaim_focus = true;
         }
     }
@@ -954,6 +3918,9 @@ static void render_chat_window(bool is_dashboard) {
     if (g_input_focused && !was_focused) {
         g_input_just_focused = true;
     }
+    if (g_input_focused != was_focused) {
+        mark_dirty(g_hud_retained);
+    }
 
     ImGui::PopID();
 
@@ -966,13 +3933,14 @@ static void render_chat_window(bool is_dashboard) {
 
 extern "C" void imgui_update_laser_state(int controller_idx, bool hit, float x, float y) {
     if (controller_idx >= 0 && controller_idx < 2) {
-        g_laser_states[controller_idx].active = hit;
-        g_laser_states[controller_idx].x = x;
-        g_laser_states[controller_idx].y = y;
+        g_input_staging.lasers[controller_idx] = {hit, x, y};
+        update_laser_cursor(controller_idx, hit, x, y);
     }
 }
 
+// Only used with cursor overlays off; otherwise see Laser Cursors
 static void render_laser_pointers() {
+    if (g_cursor_overlays.load(std::memory_order_relaxed)) return;
     ImDrawList* draw_list = ImGui::GetForegroundDrawList();
 
     for (int i = 0; i < 2; i++) {
@@ -997,18 +3965,42 @@ static void render_laser_pointers() {
 
 // Render HUD overlay (chat only)
 extern "C" bool imgui_render_hud(uint32_t width, uint32_t height) {
+    apply_input_snapshot();
+    drain_chat_inbox();
+    update_emote_atlas();
+
+    uint32_t target_width, target_height;
+    hud_target_size(width, height, &target_width, &target_height);
+    if (target_width != g_hud_swapchain.width || target_height != g_hud_swapchain.height) {
+        mark_dirty(g_hud_retained);
+    }
+
+    bool hud_active = g_laser_states[0].active || g_laser_states[1].active || g_input_focused;
+    if (!schedule_due(OVERLAY_HUD, hud_active)) return true;
+    if (!needs_render(g_hud_retained)) return true;
+
+    if (!swapchain_acquire(g_hud_swapchain, target_width, target_height, g_quality[OVERLAY_HUD])) {
+        return false;
+    }
+    publish_hud_target_size(target_width, target_height);
+    RenderTarget* target = swapchain_target(g_hud_swapchain);
+    if (!target) {
+        mark_dirty(g_hud_retained);  // GPU still busy; retry next frame
+        return true;
+    }
+
     // Update mouse from injected position
     ImGuiIO& io = ImGui::GetIO();
     io.MousePos = ImVec2(g_mouse_x, g_mouse_y);
     io.MouseDown[0] = g_mouse_down;
+    io.DisplaySize = ImVec2((float)target_width, (float)target_height);
 
     // Start new frame
-    ImGui_ImplDX11_NewFrame();
+    double ui_start = now_seconds();
+    AllocationMark ui_allocs = allocation_mark();
+    backend_new_frame();
     ImGui::NewFrame();
-
-    // Clear background
-    float clear_color[4] = { 0.05f, 0.05f, 0.05f, 0.95f };
-    g_context->ClearRenderTargetView(g_rtvs[g_current_tex], clear_color);
+    g_imgui_frame_ready = true;
 
     // Render chat window
     render_chat_window(false);  // false = HUD mode
@@ -1018,74 +4010,103 @@ extern "C" bool imgui_render_hud(uint32_t width, uint32_t height) {
 
     // Render to texture
     ImGui::Render();
-    g_context->OMSetRenderTargets(1, &g_rtvs[g_current_tex], nullptr);
-    
-    D3D11_VIEWPORT vp = {};
-    vp.Width = (float)width;
-    vp.Height = (float)height;
-    vp.MaxDepth = 1.0f;
-    g_context->RSSetViewports(1, &vp);
-    
-    ImGui_ImplDX11_RenderDrawData(ImGui::GetDrawData());
+    record_stage(STAGE_UI, ui_start);
+    record_allocations(ui_allocs);
+    ImDrawData* draw_data = ImGui::GetDrawData();
+
+    // Clear and redraw only what changed in this buffer
+    DamageRect damage;
+    bool partial = take_damage(g_hud_damage, g_hud_swapchain, draw_data, damage);
+
+    // Nothing visible changed (e.g. only the pointer moved): leave the
+    // texture and the compositor alone
+    if (partial && damage.empty()) return true;
+
+    double draw_start = now_seconds();
+    int gpu_timer = gpu_timer_begin();
+    backend_bind_target(target);
+    float clear_color[4] = { 0.05f, 0.05f, 0.05f, 0.95f };
+    clear_render_target(target, clear_color, partial ? &damage : nullptr, g_hud_swapchain.scale);
+    if (partial) clip_draw_data(draw_data, damage);
+    scale_draw_data(draw_data, g_hud_swapchain.scale);
+    backend_render_draw_data(draw_data);
+    backend_resolve_target(target);
+    gpu_timer_end(gpu_timer);
+    record_stage(STAGE_DRAW, draw_start);
     
     // Submit to OpenVR
-    Texture_t vr_tex = {};
-    vr_tex.handle = g_textures[g_current_tex];
-    vr_tex.eType = TextureType_DirectX;
-    vr_tex.eColorSpace = ColorSpace_Gamma;
-    
-    VROverlayError err = VROverlay()->SetOverlayTexture(g_handle, &vr_tex);
+    double submit_start = now_seconds();
+    VROverlayError err = backend_submit_target(g_handle, target);
+    record_stage(STAGE_SUBMIT, submit_start);
     
     // Swap buffers
-    g_current_tex = (g_current_tex + 1) % 2;
+    swapchain_advance(g_hud_swapchain);
     
     return err == VROverlayError_None;
 }
 
-// Process dashboard events
+// Dashboard counts as focused while the pointer has produced events recently
+static const double DASHBOARD_FOCUS_TIMEOUT_S = 0.5;
+static double g_dashboard_last_input_time = -1.0;
+
+// Apply the dashboard's events, routed by the event pump
 extern "C" void vr_process_dashboard_events() {
-    VREvent_t event;
-    while (g_vro->PollNextOverlayEvent(g_dashboard_handle, &event, sizeof(event))) {
-        switch (event.eventType) {
-            case VREvent_MouseMove: {
-                g_mouse_x = event.data.mouse.x;
-                g_mouse_y = event.data.mouse.y;
-                break;
-            }
-            case VREvent_MouseButtonDown: {
-                if (event.data.mouse.button == VRMouseButton_Left) {
-                    g_mouse_down = true;
-                }
-                break;
-            }
-            case VREvent_MouseButtonUp: {
-                if (event.data.mouse.button == VRMouseButton_Left) {
-                    g_mouse_down = false;
-                }
-                break;
-            }
-        }
+    // A click whose release was held back drains, and redraws, next frame
+    if (drain_pointer_events(OVERLAY_DASHBOARD, g_dashboard_pointer)) {
+        mark_dirty(g_dashboard_retained);
+        g_dashboard_last_input_time = now_seconds();
     }
 }
 
 // Render Dashboard overlay (settings only)
 extern "C" bool imgui_render_dashboard(uint32_t width, uint32_t height) {
     // Process dashboard events first
+    apply_input_snapshot();
+    drain_chat_inbox();
     vr_process_dashboard_events();
+
+    // Nothing to draw while the dashboard is closed
+    if (!g_vro->IsOverlayVisible(g_dashboard_handle)) return true;
+
+    bool dashboard_focused = now_seconds() - g_dashboard_last_input_time < DASHBOARD_FOCUS_TIMEOUT_S;
+    if (!schedule_due(OVERLAY_DASHBOARD, dashboard_focused)) return true;
+    if (!needs_render(g_dashboard_retained)) return true;
+
+    if (!swapchain_acquire(g_dashboard_swapchain, width, height, g_quality[OVERLAY_DASHBOARD])) {
+        return false;
+    }
+    RenderTarget* target = swapchain_target(g_dashboard_swapchain);
+    if (!target) {
+        mark_dirty(g_dashboard_retained);  // GPU still busy; retry next frame
+        return true;
+    }
+
+    // Mouse events stay in logical pixels whatever the target resolution
+    static uint32_t mouse_scale_width = 0, mouse_scale_height = 0;
+    if (mouse_scale_width != width || mouse_scale_height != height) {
+        HmdVector2_t mouse_scale = {{(float)width, (float)height}};
+        g_vro->SetOverlayMouseScale(g_dashboard_handle, &mouse_scale);
+        mouse_scale_width = width;
+        mouse_scale_height = height;
+    }
     
     // Update mouse from dashboard events
     ImGuiIO& io = ImGui::GetIO();
-    io.MousePos = ImVec2(g_mouse_x, g_mouse_y);
-    io.MouseDown[0] = g_mouse_down;
+    io.MousePos = ImVec2(g_dashboard_pointer.x, g_dashboard_pointer.y);
+    io.MouseDown[0] = g_dashboard_pointer.down;
     io.DisplaySize = ImVec2((float)width, (float)height);
 
     // Start new frame
-    ImGui_ImplDX11_NewFrame();
+    double ui_start = now_seconds();
+    AllocationMark ui_allocs = allocation_mark();
+    backend_new_frame();
     ImGui::NewFrame();
+    g_imgui_frame_ready = true;
 
     // Clear background
+    backend_bind_target(target);
     float clear_color[4] = { 0.1f, 0.1f, 0.1f, 1.0f };
-    g_context->ClearRenderTargetView(g_dashboard_rtvs[g_dashboard_current_tex], clear_color);
+    backend_clear_target(target, clear_color, nullptr);
 
     // Always render settings window in dashboard
     render_settings_window();
@@ -1094,26 +4115,24 @@ extern "C" bool imgui_render_dashboard(uint32_t width, uint32_t height) {
 
     // Render to texture
     ImGui::Render();
-    g_context->OMSetRenderTargets(1, &g_dashboard_rtvs[g_dashboard_current_tex], nullptr);
-    
-    D3D11_VIEWPORT vp = {};
-    vp.Width = (float)width;
-    vp.Height = (float)height;
-    vp.MaxDepth = 1.0f;
-    g_context->RSSetViewports(1, &vp);
-    
-    ImGui_ImplDX11_RenderDrawData(ImGui::GetDrawData());
+    record_stage(STAGE_UI, ui_start);
+    record_allocations(ui_allocs);
+
+    double draw_start = now_seconds();
+    int gpu_timer = gpu_timer_begin();
+    scale_draw_data(ImGui::GetDrawData(), g_dashboard_swapchain.scale);
+    backend_render_draw_data(ImGui::GetDrawData());
+    backend_resolve_target(target);
+    gpu_timer_end(gpu_timer);
+    record_stage(STAGE_DRAW, draw_start);
     
     // Submit to OpenVR
-    Texture_t vr_tex = {};
-    vr_tex.handle = g_dashboard_textures[g_dashboard_current_tex];
-    vr_tex.eType = TextureType_DirectX;
-    vr_tex.eColorSpace = ColorSpace_Gamma;
-    
-    VROverlayError err = VROverlay()->SetOverlayTexture(g_dashboard_handle, &vr_tex);
+    double submit_start = now_seconds();
+    VROverlayError err = backend_submit_target(g_dashboard_handle, target);
+    record_stage(STAGE_SUBMIT, submit_start);
     
     // Swap buffers
-    g_dashboard_current_tex = (g_dashboard_current_tex + 1) % 2;
+    swapchain_advance(g_dashboard_swapchain);
     
     return err == VROverlayError_None;
 }
@@ -1127,23 +4146,221 @@ extern "C" bool imgui_render_and_submit(uint32_t width, uint32_t height, bool is
     }
 }
 
+// ─────────────────────────── Render Thread ─────────────────────────────
+// Optionally the native side renders on a thread of its own, so Rust only
+// samples poses and input and posts state (setters, chat appends,
+// vr_keyboard_post, imgui_publish_input). Each publish wakes the thread,
+// which builds and submits frame N while Rust is already sampling for frame
+// N+1; submitted frames alternate between two textures, so the GPU finishing
+// one overlaps with the next build. From start to stop the thread owns ImGui
+// and the immediate context: the inline render entry points (imgui_render_*,
+// vr_keyboard_render) must not be called while it runs. Backends whose
+// context can't leave the embedding thread (GL) always render inline, and
+// vr_render_thread_start() reports that.
+static std::thread g_render_thread;
+static uint32_t g_render_hud_width = 0;
+static uint32_t g_render_hud_height = 0;
+static uint32_t g_render_dashboard_width = 0;
+static uint32_t g_render_dashboard_height = 0;
+static std::atomic<uint64_t> g_render_submit_errors{0};
+
+// Without publishes (Rust stalled) scheduled redraws still run at this pace
+static const int RENDER_THREAD_IDLE_WAKE_MS = 33;
+
+static void render_thread_frame() {
+    apply_input_snapshot();
+    const InputSnapshot& in = g_input_applied;
+
+    uint64_t errors = 0;
+    if (in.keyboard_handle != k_ulOverlayHandleInvalid &&
+        !vr_keyboard_render(in.keyboard_handle, in.keyboard_selected_x,
+                            in.keyboard_selected_y, in.keyboard_text)) {
+        errors++;
+    }
+    if (!imgui_render_hud(g_render_hud_width, g_render_hud_height)) errors++;
+    if (!imgui_render_dashboard(g_render_dashboard_width, g_render_dashboard_height)) errors++;
+    if (!vr_registry_render()) errors++;
+    vr_compositor_sync();
+
+    if (errors) g_render_submit_errors.fetch_add(errors, std::memory_order_relaxed);
+}
+
+static void render_thread_main() {
+    std::unique_lock<std::mutex> lock(g_render_kick_mutex);
+    while (g_render_thread_running.load(std::memory_order_acquire)) {
+        g_render_kick_cv.wait_for(lock, std::chrono::milliseconds(RENDER_THREAD_IDLE_WAKE_MS), [] {
+            return g_render_kicked || !g_render_thread_running.load(std::memory_order_acquire);
+        });
+        if (!g_render_thread_running.load(std::memory_order_acquire)) break;
+        g_render_kicked = false;
+
+        lock.unlock();
+        render_thread_frame();
+        lock.lock();
+    }
+}
+
+// Start rendering on the native thread. Call after imgui_init and
+// vr_keyboard_init_rendering, from the thread that made those calls.
+extern "C" bool vr_render_thread_start(uint32_t hud_width, uint32_t hud_height,
+                                       uint32_t dashboard_width, uint32_t dashboard_height) {
+    if (!backend_supports_render_thread()) return false;
+    if (g_render_thread.joinable() || !g_imgui_ctx) return false;
+
+    g_render_hud_width = hud_width;
+    g_render_hud_height = hud_height;
+    g_render_dashboard_width = dashboard_width;
+    g_render_dashboard_height = dashboard_height;
+    g_render_kicked = true;  // Draw the first frame right away
+
+    g_render_thread_running.store(true, std::memory_order_release);
+    g_render_thread = std::thread(render_thread_main);
+    return true;
+}
+
+extern "C" void vr_render_thread_stop() {
+    if (!g_render_thread.joinable()) return;
+    {
+        std::lock_guard<std::mutex> lock(g_render_kick_mutex);
+        g_render_thread_running.store(false, std::memory_order_release);
+    }
+    g_render_kick_cv.notify_all();
+    g_render_thread.join();
+}
+
+// Overlay submissions that failed on the render thread since it started
+extern "C" uint64_t vr_render_thread_submit_errors() {
+    return g_render_submit_errors.load(std::memory_order_relaxed);
+}
+
+// ─────────────────────────── Benchmark ─────────────────────────────────
+// Headless benchmark of the UI build. The real chat, dashboard and keyboard
+// UI run on a null backend: no device, no OpenVR, nothing rasterized or
+// submitted. Chat, pointer and keyboard input arrive through the normal
+// entry points (imgui_chat_*, imgui_inject_*, vr_keyboard_post,
+// imgui_publish_input), and each vr_bench_frame reports its CPU time, the
+// ImGui heap allocations it made and the geometry it produced.
+struct BenchFrameStats {
+    double cpu_ms;
+    uint32_t allocations;
+    uint64_t allocated_bytes;
+    uint32_t vertices;
+    uint32_t indices;
+};
+
+static bool g_bench_mode = false;
+static uint32_t g_bench_dashboard_width = 0;
+static uint32_t g_bench_dashboard_height = 0;
+// Set up ImGui without a renderer backend. Only valid in place of
+// imgui_init, never next to it.
+extern "C" bool vr_bench_init(uint32_t dashboard_width, uint32_t dashboard_height) {
+    if (g_imgui_ctx) return false;
+
+    install_imgui_heap();
+    IMGUI_CHECKVERSION();
+    g_imgui_ctx = ImGui::CreateContext();
+    ImGui::SetCurrentContext(g_imgui_ctx);
+    configure_imgui_context(1024, 768);
+
+    // No backend builds the font atlas for us
+    ImGuiIO& io = ImGui::GetIO();
+    unsigned char* pixels = nullptr;
+    int atlas_width = 0, atlas_height = 0;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &atlas_width, &atlas_height);
+    io.Fonts->SetTexID((ImTextureID)(intptr_t)1);
+    io.DeltaTime = 1.0f / 90.0f;
+
+    g_keyboard_draw_list = IM_NEW(ImDrawList)(ImGui::GetDrawListSharedData());
+    g_bench_dashboard_width = dashboard_width;
+    g_bench_dashboard_height = dashboard_height;
+    g_bench_mode = true;
+    return true;
+}
+
+static void bench_count_geometry(const ImDrawData* draw_data, BenchFrameStats& stats) {
+    stats.vertices += (uint32_t)draw_data->TotalVtxCount;
+    stats.indices += (uint32_t)draw_data->TotalIdxCount;
+}
+
+// Build one frame of every overlay's UI, as the render path would
+extern "C" bool vr_bench_frame(BenchFrameStats* out) {
+    if (!g_bench_mode || !out) return false;
+
+    uint64_t allocations = g_imgui_allocations.load(std::memory_order_relaxed);
+    uint64_t allocated_bytes = g_imgui_allocated_bytes.load(std::memory_order_relaxed);
+    BenchFrameStats stats = {};
+    double start = now_seconds();
+
+    apply_input_snapshot();
+    drain_chat_inbox();
+    ImGuiIO& io = ImGui::GetIO();
+    io.MousePos = ImVec2(g_mouse_x, g_mouse_y);
+    io.MouseDown[0] = g_mouse_down;
+
+    // HUD
+    uint32_t hud_width, hud_height;
+    hud_target_size(1024, 768, &hud_width, &hud_height);
+    io.DisplaySize = ImVec2((float)hud_width, (float)hud_height);
+    ImGui::NewFrame();
+    g_imgui_frame_ready = true;
+    render_chat_window(false);
+    render_laser_pointers();
+    ImGui::Render();
+    bench_count_geometry(ImGui::GetDrawData(), stats);
+
+    // Dashboard
+    io.DisplaySize = ImVec2((float)g_bench_dashboard_width, (float)g_bench_dashboard_height);
+    ImGui::NewFrame();
+    render_settings_window();
+    ImGui::Render();
+    bench_count_geometry(ImGui::GetDrawData(), stats);
+
+    // Keyboard, while one is posted
+    const InputSnapshot& in = g_input_applied;
+    if (in.keyboard_handle != k_ulOverlayHandleInvalid) {
+        build_keyboard_draw_list(g_keyboard_draw_list, in.keyboard_selected_x,
+                                 in.keyboard_selected_y, in.keyboard_text);
+        stats.vertices += (uint32_t)g_keyboard_draw_list->VtxBuffer.Size;
+        stats.indices += (uint32_t)g_keyboard_draw_list->IdxBuffer.Size;
+    }
+
+    stats.cpu_ms = (now_seconds() - start) * 1000.0;
+    stats.allocations = (uint32_t)(g_imgui_allocations.load(std::memory_order_relaxed) - allocations);
+    stats.allocated_bytes = g_imgui_allocated_bytes.load(std::memory_order_relaxed) - allocated_bytes;
+    *out = stats;
+    return true;
+}
+
+extern "C" void vr_bench_shutdown() {
+    if (!g_bench_mode) return;
+    IM_DELETE(g_keyboard_draw_list);
+    g_keyboard_draw_list = nullptr;
+    g_imgui_frame_ready = false;
+    ImGui::DestroyContext(g_imgui_ctx);
+    g_imgui_ctx = nullptr;
+    g_bench_mode = false;
+}
+
 // ─────────────────────────── Dashboard State Functions ─────────────────────
 extern "C" void imgui_update_dashboard_state(const DashboardState* state) {
+    // Rust pushes this every frame; the render side only reacts to changes
     if (state) {
-        g_dashboard_state = *state;
-        g_dashboard_state_changed = true;
+        g_input_staging.dashboard = *state;
+        g_input_staging.has_dashboard = true;
     }
 }
 
 extern "C" void imgui_update_overlay_settings(const OverlaySettingsFFI* settings) {
     if (settings) {
-        g_overlay_settings = *settings;
+        g_input_staging.settings = *settings;
+        g_input_staging.has_settings = true;
     }
 }
 
 extern "C" bool imgui_get_dashboard_state(DashboardState* state) {
+    std::lock_guard<std::mutex> lock(g_outbox_mutex);
     if (state && g_dashboard_state_changed) {
-        *state = g_dashboard_state;
+        *state = g_dashboard_outbox;
         g_dashboard_state_changed = false;
         return true;
     }
@@ -2,6 +2,7 @@
 #include <cfloat>
 #include <cstdint>
 #include <vector>
+#include <algorithm>
 #include <string>
 #include <iostream>
 #include <chrono>
@@ -112,6 +113,13 @@ struct LaserHit {
     float distance;
 };
 
+struct LaserBatchHit {
+    bool hit;
+    uint32_t overlay_index;
+    float u, v;
+    float distance;
+};
+
 // Dashboard State types (matching the real implementation)
 struct OverlaySettingsFFI {
     bool show_chat;
@@ -129,6 +137,31 @@ struct DashboardState {
     int current_tab;
 };
 
+static const int STAGE_COUNT = 7;
+
+struct FrameStageStats {
+    float last_ms;
+    float p50_ms;
+    float p99_ms;
+    float max_ms;
+    uint32_t samples;
+};
+
+struct FrameStats {
+    FrameStageStats stages[STAGE_COUNT];
+    uint32_t ui_allocations;
+    uint32_t ui_heap_allocations;
+    uint64_t heap_allocations;
+};
+
+struct BenchFrameStats {
+    double cpu_ms;
+    uint32_t allocations;
+    uint64_t allocated_bytes;
+    uint32_t vertices;
+    uint32_t indices;
+};
+
 // Global state for stub
 static VROverlayHandle_t g_handle = 1;  // Non-zero to indicate success
 static VROverlayHandle_t g_keyboard_handle = 2;
@@ -156,7 +189,16 @@ struct ChatMessage {
     char text[256];
 };
 
+struct ChatRecordFFI {
+    uint32_t author_offset;
+    uint32_t author_len;
+    uint32_t text_offset;
+    uint32_t text_len;
+};
+
 static std::vector<ChatMessage> g_chat_messages;
+static const size_t CHAT_RING_CAPACITY = 200;
+static uint64_t g_chat_seq = 0;
 static char g_input_buffer[256] = {0};
 static bool g_message_sent = false;
 static bool g_input_focused = false;
@@ -258,6 +300,11 @@ extern "C" void vr_wait_get_poses() {
     last_time = std::chrono::high_resolution_clock::now();
 }
 
+extern "C" void vr_wait_frame() {
+    // Same simulated 90 Hz timing as vr_wait_get_poses
+    vr_wait_get_poses();
+}
+
 // Controller functions
 extern "C" void vr_update_controllers() {
     // No-op in stub
@@ -293,16 +340,34 @@ extern "C" LaserHit vr_test_laser_intersection_main(int controller_idx) {
     return result;
 }
 
+extern "C" size_t vr_test_laser_batch(const int* controllers, size_t controller_count,
+                                      const uint64_t* overlays, size_t overlay_count,
+                                      LaserBatchHit* out_hits) {
+    if (!out_hits) return 0;
+    for (size_t i = 0; i < controller_count; i++) {
+        out_hits[i] = {false, UINT32_MAX, 0.0f, 0.0f, FLT_MAX};
+    }
+    return 0;
+}
+
+extern "C" uint64_t vr_get_hud_overlay_handle() {
+    return 0;
+}
+
 extern "C" void vr_trigger_haptic_pulse(int controller_idx, unsigned short duration_us) {
     // No-op in stub
 }
 
-extern "C" uint32_t vr_find_hip_tracker() {
-    return 0xFFFFFFFF;  // No tracker
+extern "C" bool vr_get_hip_tracker_changed(uint32_t* index) {
+    return false;
+}
+
+extern "C" void vr_set_hip_tracker_serial(const char* serial) {
+    std::cout << "[STUB] Hip tracker serial: " << (serial ? serial : "") << "\n";
 }
 
 // ImGui functions
-extern "C" void imgui_init(void* device_ptr, void* context_ptr) {
+extern "C" bool imgui_init(void* device_ptr, void* context_ptr) {
     std::cout << "[STUB] Initializing ImGui\n";
     
     IMGUI_CHECKVERSION();
@@ -324,6 +389,7 @@ extern "C" void imgui_init(void* device_ptr, void* context_ptr) {
     style.WindowBorderSize = 0.0f;
     style.ScaleAllSizes(1.5f);
     io.FontGlobalScale = 1.5f;
+    return true;
 }
 
 extern "C" void imgui_shutdown() {
@@ -349,16 +415,66 @@ extern "C" void imgui_inject_mouse_button(int button, bool down) {
     }
 }
 
+extern "C" void imgui_set_retained_mode(bool enabled) {
+    std::cout << "[STUB] Retained mode: " << (enabled ? "on" : "off") << "\n";
+}
+
+extern "C" void vr_overlay_set_target_rate(int overlay_id, float active_hz, float idle_hz) {
+    std::cout << "[STUB] Overlay " << overlay_id << " target rate: "
+              << active_hz << " Hz active, " << idle_hz << " Hz idle\n";
+}
+
+extern "C" void imgui_publish_input() {
+    // Stub mode reads injected state directly
+}
+
+extern "C" void imgui_mark_dirty() {
+    // No-op in stub - every render call runs
+}
+
 extern "C" bool imgui_get_input_focused() {
     bool result = g_input_just_focused;
     g_input_just_focused = false;
     return result;
 }
 
-extern "C" void imgui_update_chat_state(const uint8_t* messages_ptr, size_t messages_count,
-                                       uint8_t* input_buffer, size_t input_capacity) {
-    // In stub mode, we maintain our own test messages
-    // Don't clear them when updating from Rust
+extern "C" uint64_t imgui_chat_append_packed(const uint8_t* bytes, size_t bytes_len,
+                                             const ChatRecordFFI* records, size_t records_count) {
+    if (!bytes || !records || records_count == 0) return g_chat_seq;
+
+    // Stub mode keeps the fixed-size layout and simply truncates
+    for (size_t i = 0; i < records_count; i++) {
+        const ChatRecordFFI& r = records[i];
+        ChatMessage msg = {};
+        if ((size_t)r.author_offset + r.author_len <= bytes_len) {
+            memcpy(msg.author, bytes + r.author_offset,
+                   std::min<size_t>(r.author_len, sizeof(msg.author) - 1));
+        }
+        if ((size_t)r.text_offset + r.text_len <= bytes_len) {
+            memcpy(msg.text, bytes + r.text_offset,
+                   std::min<size_t>(r.text_len, sizeof(msg.text) - 1));
+        }
+        g_chat_messages.push_back(msg);
+    }
+    if (g_chat_messages.size() > CHAT_RING_CAPACITY) {
+        g_chat_messages.erase(g_chat_messages.begin(),
+                              g_chat_messages.end() - CHAT_RING_CAPACITY);
+    }
+
+    g_chat_seq += records_count;
+    return g_chat_seq;
+}
+
+extern "C" void imgui_chat_clear() {
+    g_chat_messages.clear();
+}
+
+extern "C" uint64_t imgui_chat_sequence() {
+    return g_chat_seq;
+}
+
+extern "C" void imgui_chat_set_history_budget(size_t bytes) {
+    std::cout << "[STUB] Chat history budget: " << bytes << " bytes\n";
 }
 
 extern "C" bool imgui_get_sent_message(uint8_t* buffer, size_t capacity) {
@@ -499,6 +615,116 @@ extern "C" bool vr_keyboard_render(VROverlayHandle_t handle,
     return true;
 }
 
+extern "C" void vr_keyboard_post(VROverlayHandle_t handle,
+                                 float selected_x, float selected_y,
+                                 const char* current_text) {
+    // No-op in stub
+}
+
+extern "C" bool vr_render_thread_start(uint32_t hud_width, uint32_t hud_height,
+                                       uint32_t dashboard_width, uint32_t dashboard_height) {
+    // The stub renders inline from the Rust loop
+    std::cout << "[STUB] Render thread not available, rendering inline\n";
+    return false;
+}
+
+extern "C" void vr_overlay_set_quality(int overlay_id, float supersample, bool mipmaps) {
+    // No-op in stub
+}
+
+extern "C" void vr_set_swapchain_buffers(int count) {
+    // No-op in stub
+}
+
+extern "C" void vr_set_damage_tracking(bool enabled) {
+    // No-op in stub
+}
+
+extern "C" void vr_set_laser_cursor_overlays(bool enabled) {
+    // No-op in stub
+}
+
+extern "C" bool vr_get_hud_target_size(uint32_t* width, uint32_t* height) {
+    if (!width || !height) return false;
+    *width = 1024;
+    *height = 768;
+    return true;
+}
+
+extern "C" bool vr_get_frame_stats(FrameStats* out) {
+    if (!out) return false;
+    memset(out, 0, sizeof(FrameStats));
+    return true;
+}
+
+// The stub has no real ImGui to benchmark
+extern "C" bool vr_bench_init(uint32_t dashboard_width, uint32_t dashboard_height) {
+    std::cout << "[STUB] Benchmark needs the real wrapper, not the stub\n";
+    return false;
+}
+
+extern "C" bool vr_bench_frame(BenchFrameStats* out) {
+    return false;
+}
+
+extern "C" void vr_bench_shutdown() {
+    // No-op in stub
+}
+
+extern "C" void vr_render_thread_stop() {
+    // No-op in stub
+}
+
+extern "C" uint64_t vr_render_thread_submit_errors() {
+    return 0;
+}
+
+extern "C" int32_t vr_registry_create(const char* key, const char* name,
+                                      uint32_t width, uint32_t height, float width_m) {
+    std::cout << "[STUB] Registering overlay: " << key << "\n";
+    static int32_t next_id = 0;
+    return next_id++;
+}
+
+extern "C" void vr_registry_destroy(int32_t id) {
+    // No-op in stub
+}
+
+extern "C" VROverlayHandle_t vr_registry_handle(int32_t id) {
+    return k_ulOverlayHandleInvalid;
+}
+
+extern "C" void vr_registry_set_visible(int32_t id, bool visible) {
+    // No-op in stub
+}
+
+extern "C" void vr_registry_set_rate(int32_t id, float hz) {
+    // No-op in stub
+}
+
+extern "C" void vr_registry_set_text(int32_t id, const char* title, const char* body) {
+    // No-op in stub
+}
+
+extern "C" void vr_alert_post(int kind, const char* title, const char* body) {
+    std::cout << "[STUB] Alert: " << (title ? title : "") << " " << (body ? body : "") << "\n";
+}
+
+extern "C" void imgui_set_font_cache_dir(const char* dir) {
+    // No-op in stub
+}
+
+extern "C" bool vr_emote_register(const char* name, const uint8_t* rgba,
+                                  uint32_t width, uint32_t height) {
+    // No-op in stub
+    return true;
+}
+
+extern "C" bool vr_registry_render() {
+    // In stub mode, we don't actually render
+    return true;
+}
+
 // Settings window rendering function
 static void render_settings_window() {
     ImGui::ImGuiWindowFlags_ window_flags = ImGui::ImGuiWindowFlags_NoCollapse;